@@ -9,8 +9,10 @@ from .utils import (
     get_downloads_dir,
     get_archive_ext_and_type,
     extract_archive_file,
+    get_archive_content_size,
     validate_file_checksum,
     calculate_file_checksum,
+    get_checksum_object,
 )
 
 
@@ -25,6 +27,8 @@ __all__ = (
     "get_downloads_dir",
     "get_archive_ext_and_type",
     "extract_archive_file",
+    "get_archive_content_size",
     "validate_file_checksum",
     "calculate_file_checksum",
+    "get_checksum_object",
 )
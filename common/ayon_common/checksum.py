@@ -0,0 +1,213 @@
+"""Checksum calculation of files.
+
+Files are read using 'readinto' to reusable page-aligned buffers, so no
+new bytes object is created for each read chunk. Buffers are big enough
+that hash functions release GIL during update, so multiple files can be
+hashed in parallel by threads.
+
+Algorithms of 'hashlib' and 'crc32' are always available. 'blake3' and
+'xxh3' algorithms are available when 'blake3' or 'xxhash' python modules
+are installed, they are used only when server defines them as checksum
+algorithm of a file.
+"""
+
+import os
+import mmap
+import zlib
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+# 'hashlib' releases GIL for updates bigger than 2047 bytes, bigger
+#   buffer also lowers number of read calls
+CHECKSUM_BUFFER_SIZE = 1024 * 1024
+# Blake3 hashes bigger updates using multiple threads
+BLAKE3_ALGORITHMS = {"blake3"}
+XXHASH_ALGORITHMS = {
+    "xxh3": "xxh3_64",
+    "xxh3_64": "xxh3_64",
+    "xxh3_128": "xxh3_128",
+    "xxh64": "xxh64",
+}
+
+_buffers = threading.local()
+
+
+class Crc32:
+    """CRC32 checksum with interface of 'hashlib' objects.
+
+    CRC32 is not cryptographic hash, but is fast and is stored in zip
+    archives, so extracted files can be validated without the archive.
+    """
+
+    name = "crc32"
+
+    def __init__(self):
+        self.value = 0
+
+    def update(self, data):
+        self.value = zlib.crc32(data, self.value)
+
+    def hexdigest(self):
+        return f"{self.value:08x}"
+
+
+def _get_buffer(size):
+    buffer = getattr(_buffers, "buffer", None)
+    if buffer is None or len(buffer) < size:
+        # Anonymous mmap is aligned to memory pages
+        buffer = mmap.mmap(-1, size)
+        _buffers.buffer = buffer
+        _buffers.view = memoryview(buffer)
+    return _buffers.view[:size]
+
+
+def get_checksum_object(checksum_algorithm):
+    """Create hash object for checksum algorithm.
+
+    Args:
+        checksum_algorithm (str): Algorithm to use. ('md5', 'sha1',
+            'sha256', 'blake3', 'xxh3', ...)
+
+    Returns:
+        Any: Hash object with 'update' and 'hexdigest' methods.
+
+    Raises:
+        ValueError: Unknown or unavailable checksum algorithm.
+    """
+
+    import hashlib
+
+    algorithm = (checksum_algorithm or "").lower()
+    if algorithm == Crc32.name:
+        return Crc32()
+
+    try:
+        if algorithm in BLAKE3_ALGORITHMS:
+            import blake3
+
+            return blake3.blake3(max_threads=blake3.blake3.AUTO)
+
+        if algorithm in XXHASH_ALGORITHMS:
+            import xxhash
+
+            return getattr(xxhash, XXHASH_ALGORITHMS[algorithm])()
+
+    except ImportError:
+        raise ValueError(
+            f"Checksum algorithm '{checksum_algorithm}' is not available."
+        )
+
+    func = getattr(hashlib, checksum_algorithm or "", None)
+    if func is None:
+        raise ValueError(
+            "Unknown checksum algorithm '{}'".format(checksum_algorithm))
+    return func()
+
+
+def is_checksum_algorithm_available(checksum_algorithm):
+    """Checksum algorithm can be used.
+
+    Args:
+        checksum_algorithm (str): Algorithm name.
+
+    Returns:
+        bool: Algorithm is available.
+    """
+
+    try:
+        get_checksum_object(checksum_algorithm)
+    except ValueError:
+        return False
+    return True
+
+
+def update_checksum_from_stream(hash_obj, stream, buffer_size=None):
+    """Update hash object with rest of content of binary stream.
+
+    Args:
+        hash_obj (Any): Hash object.
+        stream (BinaryIO): Stream opened for reading in binary mode.
+        buffer_size (Optional[int]): Size of read buffer.
+
+    Returns:
+        int: Number of hashed bytes.
+    """
+
+    buffer = _get_buffer(buffer_size or CHECKSUM_BUFFER_SIZE)
+    hashed_size = 0
+    while True:
+        size = stream.readinto(buffer)
+        if not size:
+            break
+        hash_obj.update(buffer[:size])
+        hashed_size += size
+    return hashed_size
+
+
+def calculate_file_checksum(filepath, checksum_algorithm, buffer_size=None):
+    """Calculate file checksum for given algorithm.
+
+    Args:
+        filepath (str): Path to a file.
+        checksum_algorithm (str): Algorithm to use.
+        buffer_size (Optional[int]): Size of read buffer.
+
+    Returns:
+        str: Calculated checksum.
+
+    Raises:
+        ValueError: File not found or unknown checksum algorithm.
+    """
+
+    if not filepath:
+        raise ValueError("Filepath is empty.")
+
+    if not os.path.exists(filepath):
+        raise ValueError("{} doesn't exist.".format(filepath))
+
+    if not os.path.isfile(filepath):
+        raise ValueError("{} is not a file.".format(filepath))
+
+    hash_obj = get_checksum_object(checksum_algorithm)
+    with open(filepath, "rb", buffering=0) as stream:
+        update_checksum_from_stream(hash_obj, stream, buffer_size)
+    return hash_obj.hexdigest()
+
+
+def calculate_files_checksums(filepaths, checksum_algorithm, max_workers=None):
+    """Calculate checksums of multiple files in parallel.
+
+    Args:
+        filepaths (Iterable[str]): Paths to files.
+        checksum_algorithm (str): Algorithm to use.
+        max_workers (Optional[int]): Maximum number of files hashed at the
+            same time. Number of CPUs is used if not passed.
+
+    Returns:
+        dict[str, str]: Checksum by filepath.
+
+    Raises:
+        ValueError: File not found or unknown checksum algorithm.
+    """
+
+    filepaths = list(filepaths)
+    if max_workers is None:
+        max_workers = os.cpu_count() or 1
+    max_workers = max(1, min(max_workers, len(filepaths)))
+    if max_workers == 1:
+        return {
+            filepath: calculate_file_checksum(filepath, checksum_algorithm)
+            for filepath in filepaths
+        }
+
+    with ThreadPoolExecutor(
+        max_workers=max_workers,
+        thread_name_prefix="ayon_checksum"
+    ) as executor:
+        checksums = executor.map(
+            lambda filepath: calculate_file_checksum(
+                filepath, checksum_algorithm
+            ),
+            filepaths
+        )
+        return dict(zip(filepaths, checksums))
@@ -33,6 +33,7 @@ from ayon_common.utils import (
     is_staging_enabled,
     is_dev_mode_enabled,
 )
+from ayon_common.metadata_store import get_metadata_store
 
 
 class ChangeUserResult:
@@ -61,6 +62,13 @@ def _get_servers_path():
     return get_ayon_appdirs("used_servers.json")
 
 
+def _get_servers_store():
+    store = get_metadata_store()
+    # Servers info is read from json file by previous versions
+    store.mirror_document("servers", _get_servers_path())
+    return store
+
+
 def get_servers_info_data():
     """Metadata about used server on this machine.
 
@@ -73,17 +81,8 @@ def get_servers_info_data():
     """
 
     data = {}
-    servers_info_path = _get_servers_path()
-    if not os.path.exists(servers_info_path):
-        dirpath = os.path.dirname(servers_info_path)
-        if not os.path.exists(dirpath):
-            os.makedirs(dirpath)
-
-        return data
-
-    with open(servers_info_path, "r") as stream:
-        with contextlib.suppress(BaseException):
-            data = json.load(stream)
+    with contextlib.suppress(Exception):
+        data = _get_servers_store().get_document("servers") or {}
     return data
 
 
@@ -98,18 +97,18 @@ def add_server(url: str, username: str):
         username (str): Name of user used to log in.
     """
 
-    servers_info_path = _get_servers_path()
-    data = get_servers_info_data()
-    data["last_server"] = url
-    if "urls" not in data:
-        data["urls"] = {}
-    data["urls"][url] = {
-        "updated_dt": datetime.datetime.now().strftime("%Y/%m/%d %H:%M:%S"),
-        "username": username,
-    }
+    def _update(data):
+        data["last_server"] = url
+        if "urls" not in data:
+            data["urls"] = {}
+        data["urls"][url] = {
+            "updated_dt": (
+                datetime.datetime.now().strftime("%Y/%m/%d %H:%M:%S")
+            ),
+            "username": username,
+        }
 
-    with open(servers_info_path, "w") as stream:
-        json.dump(data, stream)
+    _get_servers_store().update_document("servers", _update, {})
 
 
 def remove_server(url: str):
@@ -125,16 +124,14 @@ def remove_server(url: str):
     if not url:
         return
 
-    servers_info_path = _get_servers_path()
-    data = get_servers_info_data()
-    if data.get("last_server") == url:
-        data["last_server"] = None
+    def _update(data):
+        if data.get("last_server") == url:
+            data["last_server"] = None
 
-    if "urls" in data:
-        data["urls"].pop(url, None)
+        if "urls" in data:
+            data["urls"].pop(url, None)
 
-    with open(servers_info_path, "w") as stream:
-        json.dump(data, stream)
+    _get_servers_store().update_document("servers", _update, {})
 
 
 def get_last_server(
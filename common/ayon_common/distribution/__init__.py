@@ -3,6 +3,8 @@ from .exceptions import (
     InstallerDistributionError,
 )
 from .control import AyonDistribution
+from .snapshot import BootSnapshot
+from .prefetch import PrefetchDaemon
 from .utils import (
     show_missing_bundle_information,
     show_installer_issue_information,
@@ -15,6 +17,8 @@ __all__ = (
     "InstallerDistributionError",
 
     "AyonDistribution",
+    "BootSnapshot",
+    "PrefetchDaemon",
 
     "show_missing_bundle_information",
     "show_installer_issue_information",
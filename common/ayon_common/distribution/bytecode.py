@@ -0,0 +1,233 @@
+"""Compilation of python sources of distributed items to bytecode.
+
+Python sources are compiled to unchecked-hash pyc files before
+distributed item is marked as updated, so first process importing the
+item does not have to compile it. Content of distributed items does not
+change, so pyc files don't have to be validated against sources.
+
+Bytecode is compiled for python version of AYON launcher. Processes
+using other python versions compile sources on their own.
+
+Bigger directories are compiled in parallel by subprocesses of AYON
+launcher. 'multiprocessing' is not used because it does not work
+with built application.
+
+Addons imported from zip archive are not extracted and 'zipimport' does
+not write bytecode caches, so the archive is rebuilt with pyc files next
+to python sources, where 'zipimport' looks for them.
+
+The file is also a script executed in a subprocess. Last argument is
+path to json file with list of files to compile.
+"""
+
+import os
+import sys
+import json
+import uuid
+import shutil
+import zipfile
+import tempfile
+import subprocess
+import py_compile
+
+from ayon_common.utils import get_ayon_launch_args
+
+# Less files than this are compiled in current process because start
+#   of subprocess would take longer than the compilation
+MIN_FILES_PER_WORKER = 200
+
+
+def get_compile_workers():
+    """Number of processes used to compile python sources of an item.
+
+    Value can be changed with 'AYON_COMPILE_WORKERS' environment variable.
+    Value '0' disables compilation.
+
+    Returns:
+        int: Number of compile processes.
+    """
+
+    value = os.getenv("AYON_COMPILE_WORKERS")
+    if value:
+        try:
+            return max(0, int(value))
+        except ValueError:
+            pass
+    return os.cpu_count() or 1
+
+
+def _get_source_files(dirpath, ddir):
+    output = []
+    for root, dirnames, filenames in os.walk(dirpath):
+        dirnames[:] = [
+            dirname
+            for dirname in dirnames
+            if dirname != "__pycache__"
+        ]
+        for filename in filenames:
+            if not filename.endswith(".py"):
+                continue
+            filepath = os.path.join(root, filename)
+            dfile = os.path.join(ddir, os.path.relpath(filepath, dirpath))
+            output.append((filepath, dfile))
+    return output
+
+
+def compile_files(files):
+    """Compile python files to unchecked-hash pyc files.
+
+    Args:
+        files (Iterable[tuple[str, str]]): Pairs of path to source file
+            and its path shown in tracebacks.
+
+    Returns:
+        int: Number of files which failed to compile.
+    """
+
+    failed = 0
+    for filepath, dfile in files:
+        try:
+            py_compile.compile(
+                filepath,
+                dfile=dfile,
+                doraise=True,
+                invalidation_mode=(
+                    py_compile.PycInvalidationMode.UNCHECKED_HASH
+                ),
+            )
+        except (py_compile.PyCompileError, OSError):
+            # Not every '.py' file is valid python code for this version
+            failed += 1
+    return failed
+
+
+def _compile_in_subprocesses(files, workers):
+    tmp_dir = tempfile.gettempdir()
+    processes = []
+    filepaths = []
+    try:
+        for idx in range(workers):
+            filepath = os.path.join(
+                tmp_dir, f"ayon_compile_{uuid.uuid4().hex}.json"
+            )
+            filepaths.append(filepath)
+            with open(filepath, "w") as stream:
+                json.dump(files[idx::workers], stream)
+
+            args = get_ayon_launch_args(
+                os.path.abspath(__file__), "--skip-bootstrap", filepath
+            )
+            processes.append(subprocess.Popen(
+                args,
+                stdout=subprocess.DEVNULL,
+                stderr=subprocess.DEVNULL,
+            ))
+
+        failed = 0
+        for process in processes:
+            if process.wait() != 0:
+                failed += 1
+        if failed:
+            raise RuntimeError(f"{failed} compile processes failed")
+
+    finally:
+        for process in processes:
+            if process.poll() is None:
+                process.kill()
+        for filepath in filepaths:
+            if os.path.exists(filepath):
+                os.remove(filepath)
+
+
+def compile_dir(dirpath, ddir=None, workers=None):
+    """Compile python sources in directory to unchecked-hash pyc files.
+
+    Args:
+        dirpath (str): Directory with python sources.
+        ddir (Optional[str]): Directory where content will be after
+            distribution. Used for paths in tracebacks.
+        workers (Optional[int]): Maximum number of compile processes.
+            Value of 'get_compile_workers' is used if not passed.
+    """
+
+    if workers is None:
+        workers = get_compile_workers()
+    if ddir is None:
+        ddir = dirpath
+
+    files = _get_source_files(dirpath, ddir)
+    workers = min(workers, len(files) // MIN_FILES_PER_WORKER)
+    if workers <= 1:
+        compile_files(files)
+    else:
+        _compile_in_subprocesses(files, workers)
+
+
+def compile_zip_archive(src_path, dst_path, ddir=None):
+    """Copy zip archive with compiled python sources added.
+
+    Sources are compiled to unchecked-hash pyc files stored next to
+    sources in the archive. Archives with pyc files are copied as they
+    are.
+
+    Args:
+        src_path (str): Path to zip archive.
+        dst_path (str): Path where archive with bytecode is created.
+        ddir (Optional[str]): Path to archive after distribution. Used
+            for paths in tracebacks.
+
+    Returns:
+        int: Number of files which failed to compile.
+    """
+
+    if ddir is None:
+        ddir = dst_path
+
+    failed = 0
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_compile_")
+    tmp_source = os.path.join(tmp_dir, "source.py")
+    tmp_pyc = os.path.join(tmp_dir, "source.pyc")
+    try:
+        with zipfile.ZipFile(src_path) as src_zip, zipfile.ZipFile(
+            dst_path, "w", zipfile.ZIP_DEFLATED
+        ) as dst_zip:
+            filenames = set(src_zip.namelist())
+            for member in src_zip.infolist():
+                content = src_zip.read(member)
+                dst_zip.writestr(member, content)
+                pyc_filename = f"{member.filename}c"
+                if (
+                    not member.filename.endswith(".py")
+                    or pyc_filename in filenames
+                ):
+                    continue
+
+                with open(tmp_source, "wb") as stream:
+                    stream.write(content)
+                try:
+                    py_compile.compile(
+                        tmp_source,
+                        cfile=tmp_pyc,
+                        dfile=os.path.join(ddir, member.filename),
+                        doraise=True,
+                        invalidation_mode=(
+                            py_compile.PycInvalidationMode.UNCHECKED_HASH
+                        ),
+                    )
+                except (py_compile.PyCompileError, OSError):
+                    failed += 1
+                    continue
+                dst_zip.write(tmp_pyc, pyc_filename)
+    finally:
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+    return failed
+
+
+def main():
+    with open(sys.argv[-1], "r") as stream:
+        files = json.load(stream)
+    compile_files(files)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,333 @@
+"""Content addressed cache of distributed archives.
+
+Archives of addons and dependency packages are stored by checksum, so the
+same archive is downloaded only once even if is used by multiple bundles.
+
+Cache can be shared and files can be corrupted on disk, so cached
+archives are validated with checksum before they are used. Archive which
+was stored or validated by this machine recently is not hashed again
+if its size, modification time and inode did not change.
+
+Modification time of access marker is used as last access time of an
+archive, so modification time of the archive changes only when its
+content changes.
+
+Cache structure:
+    <cache root>/<checksum algorithm>/<checksum>/<archive filename>
+    <cache root>/<checksum algorithm>/<checksum>/.<archive filename>.verified
+    <cache root>/<checksum algorithm>/<checksum>/.<archive filename>.accessed
+"""
+
+import os
+import json
+import time
+import uuid
+import socket
+import shutil
+import logging
+
+from ayon_common.utils import get_ayon_appdirs
+
+DEFAULT_CACHE_MAX_SIZE_GB = 10
+# Seconds for which is validated archive not hashed again
+VERIFIED_MAX_AGE = 60 * 60
+
+
+def get_artifacts_cache_dir():
+    """Root directory of artifacts cache.
+
+    Path can be changed with 'AYON_ARTIFACTS_CACHE_DIR' environment variable,
+    e.g. to share the cache between multiple users of the machine.
+
+    Returns:
+        str: Path to cache directory.
+    """
+
+    cache_dir = os.getenv("AYON_ARTIFACTS_CACHE_DIR")
+    if not cache_dir:
+        cache_dir = get_ayon_appdirs("artifacts_cache")
+    return cache_dir
+
+
+def get_artifacts_cache_max_size():
+    """Maximum size of artifacts cache in bytes.
+
+    Size in GB can be changed with 'AYON_ARTIFACTS_CACHE_MAX_SIZE'
+    environment variable. Value '0' disables the cache.
+
+    Returns:
+        int: Maximum size of cache in bytes.
+    """
+
+    size_gb = DEFAULT_CACHE_MAX_SIZE_GB
+    value = os.getenv("AYON_ARTIFACTS_CACHE_MAX_SIZE")
+    if value:
+        try:
+            size_gb = float(value)
+        except ValueError:
+            pass
+    return int(max(0.0, size_gb) * 1024 ** 3)
+
+
+class ArtifactCache:
+    """Content addressed storage of downloaded archives.
+
+    Least recently used archives are removed when size of cache exceeds
+    maximum size. Modification time of access marker next to an archive
+    is used as last access time.
+
+    Args:
+        root (Optional[str]): Cache root directory.
+        max_size (Optional[int]): Maximum size of cache in bytes.
+    """
+
+    log = logging.getLogger("ArtifactCache")
+
+    def __init__(self, root=None, max_size=None):
+        if root is None:
+            root = get_artifacts_cache_dir()
+        if max_size is None:
+            max_size = get_artifacts_cache_max_size()
+        self._root = root
+        self._max_size = max_size
+
+    @property
+    def root(self):
+        return self._root
+
+    @property
+    def enabled(self):
+        return self._max_size > 0
+
+    def _get_entry_dir(self, checksum, checksum_algorithm):
+        return os.path.join(
+            self._root, checksum_algorithm or "unknown", checksum
+        )
+
+    def get(self, checksum, checksum_algorithm):
+        """Path to cached archive with checksum.
+
+        Archive is marked as recently used.
+
+        Args:
+            checksum (str): Checksum of archive.
+            checksum_algorithm (str): Algorithm of checksum.
+
+        Returns:
+            Union[str, None]: Path to archive or None if is not cached.
+        """
+
+        if not self.enabled or not checksum:
+            return None
+
+        entry_dir = self._get_entry_dir(checksum, checksum_algorithm)
+        if not os.path.isdir(entry_dir):
+            return None
+
+        for filename in os.listdir(entry_dir):
+            if filename.startswith("."):
+                continue
+            filepath = os.path.join(entry_dir, filename)
+            if not os.path.isfile(filepath):
+                continue
+            self._mark_accessed(filepath)
+            return filepath
+        return None
+
+    def _get_accessed_path(self, filepath):
+        dirpath, filename = os.path.split(filepath)
+        return os.path.join(dirpath, f".{filename}.accessed")
+
+    def _mark_accessed(self, filepath):
+        accessed_path = self._get_accessed_path(filepath)
+        try:
+            with open(accessed_path, "a"):
+                pass
+            os.utime(accessed_path)
+        except OSError:
+            self.log.debug(
+                f"Failed to mark {filepath} as accessed", exc_info=True
+            )
+
+    def _get_access_time(self, filepath, stat):
+        try:
+            return os.stat(self._get_accessed_path(filepath)).st_mtime
+        except OSError:
+            # Archive stored by older version
+            return stat.st_mtime
+
+    def _get_verified_path(self, filepath):
+        dirpath, filename = os.path.split(filepath)
+        return os.path.join(dirpath, f".{filename}.verified")
+
+    def _get_fingerprint(self, filepath):
+        stat = os.stat(filepath)
+        return {
+            "host": socket.gethostname(),
+            "size": stat.st_size,
+            "mtime": stat.st_mtime_ns,
+            "inode": stat.st_ino,
+        }
+
+    def mark_verified(self, filepath):
+        """Store that cached archive was validated by this machine.
+
+        Args:
+            filepath (str): Path to archive in cache.
+        """
+
+        data = self._get_fingerprint(filepath)
+        data["verified_time"] = time.time()
+        verified_path = self._get_verified_path(filepath)
+        tmp_path = f"{verified_path}.{uuid.uuid4().hex}.tmp"
+        try:
+            with open(tmp_path, "w") as stream:
+                json.dump(data, stream)
+            os.replace(tmp_path, verified_path)
+        except OSError:
+            self.log.debug(
+                f"Failed to mark {filepath} as verified", exc_info=True
+            )
+        finally:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+
+    def is_verified(self, filepath):
+        """Cached archive was recently validated by this machine.
+
+        Args:
+            filepath (str): Path to archive in cache.
+
+        Returns:
+            bool: Archive does not have to be validated again.
+        """
+
+        try:
+            with open(self._get_verified_path(filepath), "r") as stream:
+                data = json.load(stream)
+            fingerprint = self._get_fingerprint(filepath)
+        except (OSError, ValueError):
+            return False
+
+        verified_time = data.pop("verified_time", None)
+        if (
+            not isinstance(verified_time, (int, float))
+            or time.time() - verified_time > VERIFIED_MAX_AGE
+        ):
+            return False
+        return data == fingerprint
+
+    def add(self, filepath, checksum, checksum_algorithm, move=True):
+        """Store archive to cache.
+
+        Archive content must be already validated with checksum.
+
+        Args:
+            filepath (str): Path to archive.
+            checksum (str): Checksum of archive.
+            checksum_algorithm (str): Algorithm of checksum.
+            move (Optional[bool]): Move archive to cache instead of copy.
+
+        Returns:
+            str: Path to archive in cache, or passed path if cache
+                is disabled.
+        """
+
+        if not self.enabled or not checksum:
+            return filepath
+
+        cached_path = self.get(checksum, checksum_algorithm)
+        if cached_path:
+            if move:
+                os.remove(filepath)
+            return cached_path
+
+        entry_dir = self._get_entry_dir(checksum, checksum_algorithm)
+        os.makedirs(entry_dir, exist_ok=True)
+        filename = os.path.basename(filepath)
+        cached_path = os.path.join(entry_dir, filename)
+        # Use temporary file so other processes don't see partial file
+        tmp_path = os.path.join(entry_dir, f".{uuid.uuid4().hex}.tmp")
+        try:
+            if move:
+                shutil.move(filepath, tmp_path)
+            else:
+                shutil.copyfile(filepath, tmp_path)
+            os.replace(tmp_path, cached_path)
+            self._mark_accessed(cached_path)
+        finally:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+        self.mark_verified(cached_path)
+
+        self.evict(keep={cached_path})
+        return cached_path
+
+    def remove(self, checksum, checksum_algorithm):
+        """Remove archive from cache, e.g. when is corrupted.
+
+        Args:
+            checksum (str): Checksum of archive.
+            checksum_algorithm (str): Algorithm of checksum.
+        """
+
+        entry_dir = self._get_entry_dir(checksum, checksum_algorithm)
+        if os.path.isdir(entry_dir):
+            shutil.rmtree(entry_dir, ignore_errors=True)
+
+    def _get_entries(self):
+        """Cached archives.
+
+        Returns:
+            list[tuple[float, int, str]]: Last access time, size and path
+                of cached archives.
+        """
+
+        output = []
+        if not os.path.isdir(self._root):
+            return output
+
+        for algorithm in os.listdir(self._root):
+            algorithm_dir = os.path.join(self._root, algorithm)
+            if not os.path.isdir(algorithm_dir):
+                continue
+            for checksum in os.listdir(algorithm_dir):
+                entry_dir = os.path.join(algorithm_dir, checksum)
+                if not os.path.isdir(entry_dir):
+                    continue
+                for filename in os.listdir(entry_dir):
+                    # Skip files which are being added
+                    if filename.startswith("."):
+                        continue
+                    filepath = os.path.join(entry_dir, filename)
+                    try:
+                        stat = os.stat(filepath)
+                    except OSError:
+                        continue
+                    output.append((
+                        self._get_access_time(filepath, stat),
+                        stat.st_size,
+                        filepath
+                    ))
+        return output
+
+    def evict(self, keep=None):
+        """Remove least recently used archives to fit maximum size.
+
+        Args:
+            keep (Optional[set[str]]): Paths that should not be removed.
+        """
+
+        keep = keep or set()
+        entries = self._get_entries()
+        total_size = sum(size for _, size, _ in entries)
+        for _, size, filepath in sorted(entries):
+            if total_size <= self._max_size:
+                break
+            if filepath in keep:
+                continue
+            self.log.debug(f"Removing {filepath} from artifacts cache")
+            shutil.rmtree(os.path.dirname(filepath), ignore_errors=True)
+            # File can be locked by other process, e.g. on Windows
+            if not os.path.exists(filepath):
+                total_size -= size
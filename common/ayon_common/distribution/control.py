@@ -2,17 +2,18 @@ import os
 import sys
 import json
 import uuid
+import time
 import ctypes
 import tempfile
 import traceback
-import collections
 import datetime
 import logging
 import shutil
-import threading
 import platform
+import contextlib
 import subprocess
 from enum import Enum
+from concurrent.futures import ThreadPoolExecutor
 
 import attr
 import ayon_api
@@ -20,26 +21,79 @@ import ayon_api
 from ayon_common.utils import (
     HEADLESS_MODE_ENABLED,
     extract_archive_file,
+    get_archive_ext_and_type,
+    get_archive_content_size,
     is_staging_enabled,
     is_dev_mode_enabled,
     get_executables_info_by_version,
     get_downloads_dir,
+    validate_file_checksum,
+    ZipFileLongPaths,
 )
+from ayon_common.tracing import get_boot_tracer, trace_span
+from ayon_common.metadata_store import get_metadata_store
 
 from .exceptions import BundleNotFoundError, InstallerDistributionError
 from .utils import (
     get_addons_dir,
     get_dependencies_dir,
+    get_sibling_dirpath,
+    can_zip_import,
+    is_zip_import_enabled,
+    remove_dir_in_background,
+    replace_dir,
+    cleanup_stale_dirs,
 )
 from .downloaders import get_default_download_factory
+from .file_handler import HTTPRangeReader
+from .delta import (
+    MIN_DELTA_ARCHIVE_SIZE,
+    is_delta_update_enabled,
+    read_manifest,
+    read_zip_manifest,
+    write_manifest,
+    create_dir_manifest,
+    extract_zip_delta,
+)
+from .verify import (
+    is_verify_installed_enabled,
+    add_compiled_files_to_manifest,
+    update_verify_cache,
+    verify_dir,
+)
+from .scheduler import DistributionPhase, DistributionScheduler
+from .locks import ItemLock, get_lock_timeout
+from .events import (
+    DistributionEventTopic,
+    DistributionEventHub,
+    ReportingTransferProgress,
+)
+from .cache import ArtifactCache
+from .peer import get_distribution_peers
+from .bytecode import (
+    compile_dir,
+    compile_zip_archive,
+    get_compile_workers,
+)
+from .import_index import (
+    is_import_index_enabled,
+    get_import_index_filename,
+    load_import_index,
+    update_import_index,
+    install_import_finder,
+)
 from .data_structures import (
     Installer,
     AddonInfo,
     DependencyItem,
     Bundle,
+    UrlType,
+    PeerSourceInfo,
 )
 
 NOT_SET = type("UNKNOWN", (), {"__bool__": lambda: False})()
+ADDON_METADATA_KIND = "addon"
+DEPENDENCY_METADATA_KIND = "dependency_package"
 
 
 class UpdateState(Enum):
@@ -53,11 +107,15 @@ class UpdateState(Enum):
 class DistributeTransferProgress:
     """Progress of single source item in 'DistributionItem'.
 
-    The item is to keep track of single source item.
+    The item is to keep track of single source item. Changes are reported
+    as distribution events when event hub is set.
     """
 
     def __init__(self):
-        self._transfer_progress = ayon_api.TransferProgress()
+        self._transfer_progress = ReportingTransferProgress()
+        self._unzip_progress = ReportingTransferProgress()
+        self._event_hub = None
+        self._item_label = None
         self._started = False
         self._failed = False
         self._fail_reason = None
@@ -66,10 +124,45 @@ class DistributeTransferProgress:
         self._hash_check_started = False
         self._hash_check_finished = False
 
+    def set_event_hub(self, event_hub, item_label):
+        """Report changes of progress to event hub.
+
+        Args:
+            event_hub (Union[DistributionEventHub, None]): Event hub.
+            item_label (str): Label of distribution item.
+        """
+
+        self._event_hub = event_hub
+        self._item_label = item_label
+        transfer_callback = unzip_callback = None
+        if event_hub is not None:
+            transfer_callback = self._get_report_callback(
+                DistributionEventTopic.TRANSFER_PROGRESS
+            )
+            unzip_callback = self._get_report_callback(
+                DistributionEventTopic.UNZIP_PROGRESS
+            )
+        self._transfer_progress.set_report_callback(transfer_callback)
+        self._unzip_progress.set_report_callback(unzip_callback)
+
+    def _get_report_callback(self, topic):
+        def callback(transferred_size, content_size):
+            self._emit(
+                topic,
+                transferred_size=transferred_size,
+                content_size=content_size,
+            )
+        return callback
+
+    def _emit(self, topic, **data):
+        if self._event_hub is not None:
+            self._event_hub.emit(topic, self._item_label, **data)
+
     def set_started(self):
         """Call when source distribution starts."""
 
         self._started = True
+        self._emit(DistributionEventTopic.SOURCE_STARTED)
 
     def set_failed(self, reason):
         """Set source distribution as failed.
@@ -80,6 +173,7 @@ class DistributeTransferProgress:
 
         self._failed = True
         self._fail_reason = reason
+        self._emit(DistributionEventTopic.SOURCE_FAILED, reason=reason)
 
     def set_hash_check_started(self):
         """Call just before hash check starts."""
@@ -125,6 +219,19 @@ class DistributeTransferProgress:
 
         return self._transfer_progress
 
+    @property
+    def unzip_progress(self):
+        """Source file extraction progress tracker.
+
+        Content size is uncompressed size of archive content, if is known,
+        and transferred size is size of already extracted files.
+
+        Returns:
+            ayon_api.TransferProgress.: Content extraction progress.
+        """
+
+        return self._unzip_progress
+
     @property
     def started(self):
         return self._started
@@ -182,6 +289,8 @@ class BaseDistributionItem:
         downloader_data (Dict[str, Any]): More information for downloaders.
         item_label (str): Label used in log outputs (and in UI).
         logger (logging.Logger): Logger object.
+        priority (Optional[int]): Items with higher priority are
+            distributed first when distributed in parallel.
     """
 
     def __init__(
@@ -195,6 +304,7 @@ class BaseDistributionItem:
         downloader_data,
         item_label,
         logger=None,
+        priority=0,
     ):
         if logger is None:
             logger = logging.getLogger(self.__class__.__name__)
@@ -207,7 +317,10 @@ class BaseDistributionItem:
         self.sources = self._prepare_sources(sources)
         self.downloader_data = downloader_data
         self.item_label = item_label
+        self.priority = priority
 
+        self._scheduler = None
+        self._event_hub = None
         self._need_distribution = state != UpdateState.UPDATED
         self._current_source_progress = None
         self._used_source_progress = None
@@ -224,6 +337,63 @@ class BaseDistributionItem:
             for source in sources
         ]
 
+    def set_scheduler(self, scheduler):
+        """Set scheduler which limits concurrency of distribution phases.
+
+        Args:
+            scheduler (Union[DistributionScheduler, None]): Scheduler object.
+        """
+
+        self._scheduler = scheduler
+
+    def set_event_hub(self, event_hub):
+        """Set event hub where progress of distribution is reported.
+
+        Args:
+            event_hub (Union[DistributionEventHub, None]): Event hub.
+        """
+
+        self._event_hub = event_hub
+        for _, source_progress in self.sources:
+            source_progress.set_event_hub(event_hub, self.item_label)
+
+    def _create_source_progress(self):
+        source_progress = DistributeTransferProgress()
+        source_progress.set_event_hub(self._event_hub, self.item_label)
+        return source_progress
+
+    def _emit_event(self, topic, **data):
+        if self._event_hub is not None:
+            self._event_hub.emit(topic, self.item_label, **data)
+
+    @contextlib.contextmanager
+    def _phase_slot(self, phase):
+        """Context manager waiting for free slot of distribution phase.
+
+        Waiting for the slot and the phase itself are traced as separate
+        spans of boot trace. Start and end of the phase are reported
+        as events.
+
+        Args:
+            phase (DistributionPhase): Distribution phase.
+        """
+
+        with contextlib.ExitStack() as stack:
+            if self._scheduler is not None:
+                with trace_span(f"wait for {phase.value}"):
+                    stack.enter_context(self._scheduler.phase_slot(phase))
+
+            self._emit_event(
+                DistributionEventTopic.PHASE_STARTED, phase=phase.value
+            )
+            try:
+                with trace_span(phase.value, item=self.item_label):
+                    yield
+            finally:
+                self._emit_event(
+                    DistributionEventTopic.PHASE_FINISHED, phase=phase.value
+                )
+
     @property
     def need_distribution(self):
         """Need distribution based on initial state.
@@ -304,14 +474,22 @@ class BaseDistributionItem:
         """
 
         download_dirpath = self.download_dirpath
+        # Calculate checksum during download only if is validated
+        checksum_algorithm = None
+        if self.checksum:
+            checksum_algorithm = self.checksum_algorithm
 
         try:
-            filepath = downloader.download(
-                source_data,
-                download_dirpath,
-                self.downloader_data,
-                source_progress.transfer_progress,
-            )
+            with self._phase_slot(DistributionPhase.DOWNLOAD):
+                filepath, calculated_checksum = (
+                    downloader.download_with_checksum(
+                        source_data,
+                        download_dirpath,
+                        self.downloader_data,
+                        source_progress.transfer_progress,
+                        checksum_algorithm,
+                    )
+                )
         except Exception:
             message = "Failed to download source"
             source_progress.set_failed(message)
@@ -327,9 +505,13 @@ class BaseDistributionItem:
             #   information about checksum at the moment.
             # TODO remove once addon can supply checksum.
             if self.checksum:
-                downloader.check_hash(
-                    filepath, self.checksum, self.checksum_algorithm
-                )
+                with self._phase_slot(DistributionPhase.HASH_CHECK):
+                    downloader.check_hash(
+                        filepath,
+                        self.checksum,
+                        self.checksum_algorithm,
+                        calculated_checksum
+                    )
         except Exception:
             message = "File hash does not match"
             source_progress.set_failed(message)
@@ -341,6 +523,25 @@ class BaseDistributionItem:
         source_progress.set_hash_check_finished()
         return filepath
 
+    def _stream_source(self, source_data, source_progress, downloader):
+        """Receive and process source in single pass.
+
+        Override this method if source can be processed while it is
+            downloaded.
+
+        Args:
+            source_data (dict[str, Any]): Source information data.
+            source_progress (DistributeTransferProgress): Object where to
+                track process of a source.
+            downloader (SourceDownloader): Downloader of source.
+
+        Returns:
+            Union[bool, None]: Same as '_post_source_process' or None
+                if source can't be processed as stream.
+        """
+
+        return None
+
     def _post_source_process(
         self, filepath, source_data, source_progress, downloader
     ):
@@ -404,6 +605,12 @@ class BaseDistributionItem:
 
         try:
             source_data = attr.asdict(source)
+            processed = self._stream_source(
+                source_data, source_progress, downloader
+            )
+            if processed is not None:
+                return processed
+
             filepath = self._receive_file(
                 source_data,
                 source_progress,
@@ -457,6 +664,8 @@ class BaseDistributionItem:
             return
 
         self._dist_started = True
+        start_time = time.perf_counter()
+        self._emit_event(DistributionEventTopic.ITEM_STARTED)
         try:
             if self.state == UpdateState.OUTDATED:
                 self._distribute()
@@ -479,6 +688,17 @@ class BaseDistributionItem:
                 self._error_msg = "Distribution failed"
 
             self._post_distribute()
+            get_boot_tracer().add_span(
+                self.item_label,
+                start_time,
+                time.perf_counter(),
+                state=self.state.value
+            )
+            self._emit_event(
+                DistributionEventTopic.ITEM_FINISHED,
+                state=self.state.value,
+                error=self._error_msg,
+            )
 
 
 def create_tmp_file(suffix=None, prefix=None):
@@ -768,85 +988,758 @@ class InstallerDistributionItem(BaseDistributionItem):
         self._installer_path = filepath
         success = False
         try:
-            if filepath:
-                self._install_file(filepath)
-                success = True
-            else:
-                message = "File was not downloaded"
-                source_progress.set_failed(message)
+            if filepath:
+                self._install_file(filepath)
+                success = True
+            else:
+                message = "File was not downloaded"
+                source_progress.set_failed(message)
+
+        except Exception as exc:
+            message = "Installation failed"
+            source_progress.set_failed(message)
+            if isinstance(exc, InstallerDistributionError):
+                self._installer_error = str(exc)
+            else:
+                self.log.warning(
+                    f"{self.item_label}: {message}",
+                    exc_info=True
+                )
+                self._installer_error = (
+                    f"Distribution of AYON launcher"
+                    " failed with unexpected reason."
+                )
+
+        self.state = (
+            UpdateState.UPDATED if success else UpdateState.UPDATE_FAILED
+        )
+
+        self._used_source = source_data
+        if success or self._cleanup_on_fail:
+            downloader.cleanup(
+                source_data,
+                self.download_dirpath,
+                self.downloader_data
+            )
+
+        return True
+
+
+class DistributionItem(BaseDistributionItem):
+    """Distribution item with sources and target directories.
+
+    Distribution item for addons and dependency packages. They have defined
+    unzip directory where the downloaded content is unzipped.
+
+    Content is extracted to a staging directory next to the unzip directory
+    which replaces the unzip directory using renames once the content is
+    ready. Previous content is kept when distribution fails and is removed
+    in background when it is replaced. Archive is downloaded to a sibling
+    directory if download directory is the unzip directory.
+
+    With zip import enabled a zip archive which can be imported by
+    'zipimport' is not extracted but stored to unzip directory as is.
+
+    Extracted zip archive has manifest of files. When directory with
+    previous version (of addon or dependency package) is passed, only
+    changed members of remote zip archive are downloaded and unchanged
+    files are reused from previous version.
+
+    Item is distributed under cross-process lock of a lock file next to
+    the unzip directory. When other process distributed the item in the
+    meantime, its result is used and the item is not distributed again.
+
+    Args:
+        unzip_dirpath (str): Path to directory where zip is downloaded.
+        download_dirpath (str): Path to directory where file is unzipped.
+        state (UpdateState): Initial state (UpdateState.UPDATED or
+            UpdateState.OUTDATED).
+        file_hash (str): Hash of file for validation.
+        factory (DownloadFactory): Downloaders factory object.
+        sources (List[SourceInfo]): Possible sources to receive the
+            distribution item.
+        downloader_data (Dict[str, Any]): More information for downloaders.
+        item_label (str): Label used in log outputs (and in UI).
+        logger (logging.Logger): Logger object.
+        artifact_cache (Optional[ArtifactCache]): Cache of downloaded
+            archives. Archive is extracted from cache if is available and
+            downloaded archives are stored to it.
+        zip_import (Optional[bool]): Keep zip archive instead of extracting
+            it if it can be imported using 'zipimport'.
+        delta_base_dirpath (Optional[str]): Directory with previous version
+            which can be used for delta update.
+    """
+
+    zip_import_filename = "addon.zip"
+
+    def __init__(
+        self,
+        unzip_dirpath,
+        *args,
+        artifact_cache=None,
+        zip_import=False,
+        delta_base_dirpath=None,
+        **kwargs
+    ):
+        self.unzip_dirpath = unzip_dirpath
+        self._artifact_cache = artifact_cache
+        self._zip_import = zip_import
+        self._delta_base_dirpath = delta_base_dirpath
+        self._staging_dirpath = None
+        self._lock = ItemLock(get_sibling_dirpath(unzip_dirpath, "lock"))
+        self._reuse_lock_result = True
+        super().__init__(*args, **kwargs)
+        # Unzip directory is replaced as whole, download next to it
+        #   so partially downloaded files are not lost on failure
+        self._own_download_dir = (
+            os.path.normpath(self.download_dirpath)
+            == os.path.normpath(unzip_dirpath)
+        )
+        if self._own_download_dir:
+            self.download_dirpath = get_sibling_dirpath(
+                unzip_dirpath, "download"
+            )
+
+    @property
+    def python_path(self):
+        """Path which should be added to python path.
+
+        Returns:
+            str: Path to zip archive if item was distributed for zip
+                import, otherwise unzip directory.
+        """
+
+        zip_path = os.path.join(self.unzip_dirpath, self.zip_import_filename)
+        if os.path.isfile(zip_path):
+            return zip_path
+        return self.unzip_dirpath
+
+    def _get_cached_archive(self):
+        cache = self._artifact_cache
+        if cache is None or not self.checksum:
+            return None
+        return cache.get(self.checksum, self.checksum_algorithm)
+
+    def _distribute_from_cache(self):
+        """Extract archive from artifacts cache if is available.
+
+        Returns:
+            bool: Item was distributed from cache.
+        """
+
+        filepath = self._get_cached_archive()
+        if not filepath:
+            return False
+
+        self.log.info(f"{self.item_label}: Using cached archive {filepath}")
+        source_progress = self._create_source_progress()
+        self._current_source_progress = source_progress
+        source_progress.set_started()
+        source_progress.set_hash_check_started()
+        if not self._validate_cached_archive(filepath):
+            message = "Cached file hash does not match"
+            source_progress.set_failed(message)
+            self.log.warning(f"{self.item_label}: {message}")
+            self._artifact_cache.remove(
+                self.checksum, self.checksum_algorithm
+            )
+            self._current_source_progress = None
+            return False
+        source_progress.set_hash_check_finished()
+
+        self._pre_source_process()
+        source_progress.set_unzip_started()
+        try:
+            with self._phase_slot(DistributionPhase.EXTRACT):
+                self._extract_archive(filepath, source_progress)
+            self._commit_staging()
+
+        except Exception:
+            message = "Couldn't unzip cached file"
+            source_progress.set_failed(message)
+            self.log.warning(
+                f"{self.item_label}: {message}",
+                exc_info=True
+            )
+            # Archive is probably corrupted
+            self._artifact_cache.remove(
+                self.checksum, self.checksum_algorithm
+            )
+            self._current_source_progress = None
+            return False
+
+        source_progress.set_unzip_finished()
+
+        self._current_source_progress = None
+        self._used_source_progress = source_progress
+        self._used_source = {"type": "cache", "path": filepath}
+        self.state = UpdateState.UPDATED
+        self.log.info(f"{self.item_label}: Distributed")
+        return True
+
+    def _validate_cached_archive(self, filepath):
+        """Validate checksum of cached archive.
+
+        Args:
+            filepath (str): Path to cached archive.
+
+        Returns:
+            bool: Archive content matches checksum.
+        """
+
+        if self._artifact_cache.is_verified(filepath):
+            return True
+
+        try:
+            with self._phase_slot(DistributionPhase.HASH_CHECK):
+                valid = validate_file_checksum(
+                    filepath, self.checksum, self.checksum_algorithm
+                )
+        except Exception:
+            self.log.warning(
+                f"{self.item_label}: Failed to validate cached file",
+                exc_info=True
+            )
+            return False
+
+        if valid:
+            self._artifact_cache.mark_verified(filepath)
+        return valid
+
+    def _extract_archive(self, filepath, source_progress, downloader=None):
+        """Extract archive to staging directory and track its progress.
+
+        Args:
+            filepath (str): Path to archive.
+            source_progress (DistributeTransferProgress): Progress of source.
+            downloader (Optional[SourceDownloader]): Downloader used to
+                extract the archive. Archive is kept if not passed.
+        """
+
+        unzip_progress = source_progress.unzip_progress
+        if self._zip_import and can_zip_import(filepath):
+            self._store_zip_archive(filepath, unzip_progress)
+            return
+
+        # Manifest of files for delta update of next version
+        manifest = None
+        _, archive_type = get_archive_ext_and_type(filepath)
+        if archive_type == "zip":
+            manifest = read_zip_manifest(filepath)
+
+        unzip_progress.set_content_size(get_archive_content_size(filepath))
+        unzip_progress.set_started()
+        callback = unzip_progress.add_transferred_chunk
+        if downloader is None:
+            extract_archive_file(
+                filepath, self._staging_dirpath, progress_callback=callback
+            )
+        else:
+            downloader.unzip(
+                filepath, self._staging_dirpath, progress_callback=callback
+            )
+        if manifest is not None:
+            write_manifest(self._staging_dirpath, manifest)
+        unzip_progress.set_transfer_done()
+
+    def _store_zip_archive(self, filepath, unzip_progress):
+        """Store zip archive to staging directory for zip import.
+
+        Archive is rebuilt with compiled python sources, 'zipimport' does
+            not store bytecode caches. Archive is hardlinked if possible
+            when compilation is disabled or fails, e.g. from artifacts
+            cache.
+
+        Args:
+            filepath (str): Path to validated zip archive.
+            unzip_progress (TransferProgress): Progress of extraction.
+        """
+
+        size = os.path.getsize(filepath)
+        unzip_progress.set_content_size(size)
+        unzip_progress.set_started()
+        dst_path = os.path.join(
+            self._staging_dirpath, self.zip_import_filename
+        )
+        if not self._compile_zip_archive(filepath, dst_path):
+            try:
+                os.link(filepath, dst_path)
+            except OSError:
+                shutil.copyfile(filepath, dst_path)
+        self.log.debug(f"{self.item_label}: Stored archive for zip import")
+        unzip_progress.add_transferred_chunk(size)
+        unzip_progress.set_transfer_done()
+
+    def _compile_zip_archive(self, filepath, dst_path):
+        """Create zip archive with compiled python sources.
+
+        Args:
+            filepath (str): Path to zip archive.
+            dst_path (str): Path to archive with bytecode.
+
+        Returns:
+            bool: Archive with bytecode was created.
+        """
+
+        if get_compile_workers() < 1:
+            return False
+
+        try:
+            with self._phase_slot(DistributionPhase.COMPILE):
+                compile_zip_archive(
+                    filepath,
+                    dst_path,
+                    ddir=os.path.join(
+                        self.unzip_dirpath, self.zip_import_filename
+                    )
+                )
+            if can_zip_import(dst_path):
+                return True
+
+        except Exception:
+            self.log.warning(
+                f"{self.item_label}: Failed to compile python sources",
+                exc_info=True
+            )
+
+        if os.path.exists(dst_path):
+            os.remove(dst_path)
+        return False
+
+    def _get_delta_base_manifest(self):
+        if (
+            not self._delta_base_dirpath
+            or self._zip_import
+            or not is_delta_update_enabled(bool(self.checksum))
+        ):
+            return None
+        return read_manifest(self._delta_base_dirpath)
+
+    def _distribute_delta(
+        self, stream_request, source_data, source_progress
+    ):
+        """Receive only changed members of remote zip archive.
+
+        Unchanged files are reused from previous version. Members are
+            validated using CRC32 from central directory of the archive.
+
+        Returns:
+            bool: Item was distributed. Source should be processed
+                regular way if 'False' is returned.
+        """
+
+        base_manifest = self._get_delta_base_manifest()
+        if base_manifest is None:
+            return False
+
+        url, headers, filename = stream_request
+        unzip_progress = source_progress.unzip_progress
+        transfer_progress = source_progress.transfer_progress
+        applied = False
+        try:
+            with self._phase_slot(DistributionPhase.DOWNLOAD):
+                with HTTPRangeReader(url, headers) as reader:
+                    if reader.size >= MIN_DELTA_ARCHIVE_SIZE:
+                        applied = self._extract_zip_delta(
+                            reader, base_manifest, source_progress
+                        )
+                    transferred = reader.transferred
+                    archive_size = reader.size
+            if applied:
+                self._commit_staging()
+
+        except Exception:
+            applied = False
+            self.log.info(
+                f"{self.item_label}: Delta update of {filename} failed,"
+                " using full archive.",
+                exc_info=True
+            )
+
+        if not applied:
+            # Start with clean staging directory
+            self._pre_source_process()
+            return False
+
+        transfer_progress.set_content_size(transferred)
+        transfer_progress.add_transferred_chunk(transferred)
+        transfer_progress.set_transfer_done()
+        unzip_progress.set_transfer_done()
+        source_progress.set_unzip_finished()
+        source_progress.set_hash_check_started()
+        source_progress.set_hash_check_finished()
+        self.log.info((
+            f"{self.item_label}: Updated from"
+            f" {self._delta_base_dirpath} using delta,"
+            f" received {transferred} of {archive_size} bytes"
+        ))
+        self.state = UpdateState.UPDATED
+        self._used_source = source_data
+        return True
+
+    def _extract_zip_delta(self, reader, base_manifest, source_progress):
+        unzip_progress = source_progress.unzip_progress
+        with ZipFileLongPaths(reader) as zip_file:
+            unzip_progress.set_content_size(sum(
+                member.file_size
+                for member in zip_file.infolist()
+            ))
+            unzip_progress.set_started()
+            source_progress.set_unzip_started()
+            return extract_zip_delta(
+                zip_file,
+                self._delta_base_dirpath,
+                base_manifest,
+                self._staging_dirpath,
+                progress_callback=unzip_progress.add_transferred_chunk,
+            )
+
+    def _stream_source(self, source_data, source_progress, downloader):
+        """Receive content of remote archive without storing the archive.
+
+        Zip archive is updated using delta from previous version if is
+            available.
+
+        Tar archive is extracted into staging directory while downloading.
+            Archive does not have to be stored, hashed and read again for
+            extraction. Staging directory is renamed to unzip directory
+            only if checksum of received content matches.
+        """
+
+        stream_request = downloader.get_stream_request(
+            source_data, self.downloader_data
+        )
+        if stream_request is None:
+            return None
+
+        filename = stream_request[2]
+        if not filename:
+            return None
+        _, archive_type = get_archive_ext_and_type(filename)
+        if archive_type == "zip":
+            if self._distribute_delta(
+                stream_request, source_data, source_progress
+            ):
+                return True
+            return None
+
+        if archive_type != "tar":
+            return None
+
+        # Archive is stored only to be added to artifacts cache
+        archive_path = None
+        cache = self._artifact_cache
+        if (
+            cache is not None
+            and cache.enabled
+            and self.checksum
+            and downloader.cacheable
+        ):
+            archive_path = os.path.join(self.download_dirpath, filename)
+
+        checksum_algorithm = None
+        if self.checksum:
+            checksum_algorithm = self.checksum_algorithm
+
+        self.log.debug(f"{self.item_label}: Extracting {filename} as stream")
+        unzip_progress = source_progress.unzip_progress
+        unzip_progress.set_started()
+        source_progress.set_unzip_started()
+        try:
+            with self._phase_slot(DistributionPhase.DOWNLOAD):
+                calculated_checksum = downloader.stream_extract(
+                    stream_request,
+                    self._staging_dirpath,
+                    source_progress.transfer_progress,
+                    checksum_algorithm,
+                    progress_callback=unzip_progress.add_transferred_chunk,
+                    archive_path=archive_path,
+                )
+
+            source_progress.set_hash_check_started()
+            if self.checksum and calculated_checksum != self.checksum:
+                raise ValueError(
+                    f"{filename} doesn't match expected hash."
+                )
+            source_progress.set_hash_check_finished()
+            self._commit_staging()
+
+        except Exception:
+            message = "Failed to download and extract source"
+            source_progress.set_failed(message)
+            self.log.warning(
+                f"{self.item_label}: {message}",
+                exc_info=True
+            )
+            if archive_path and os.path.exists(archive_path):
+                os.remove(archive_path)
+            return False
+
+        unzip_progress.set_transfer_done()
+        source_progress.set_unzip_finished()
+
+        if archive_path:
+            cached_filepath = self._add_to_cache(archive_path, downloader)
+            if cached_filepath is None and os.path.exists(archive_path):
+                os.remove(archive_path)
+
+        self.state = UpdateState.UPDATED
+        self._used_source = source_data
+        downloader.cleanup(
+            source_data,
+            self.download_dirpath,
+            self.downloader_data
+        )
+        return True
+
+    def _acquire_lock(self):
+        """Acquire lock of the item, wait for other process if needed."""
+
+        if self._lock.try_acquire():
+            return
+
+        self.log.info(
+            f"{self.item_label}: Waiting for other process"
+            " distributing the item"
+        )
+        with self._phase_slot(DistributionPhase.WAIT):
+            self._lock.acquire(get_lock_timeout())
+
+    def _use_lock_result(self):
+        """Use result of other process which distributed the item.
+
+        Returns:
+            bool: Item was distributed by other process.
+        """
+
+        if not self._reuse_lock_result:
+            return False
+
+        result = self._lock.read_result()
+        if (
+            not result
+            or result.get("checksum") != self.checksum
+            or not os.path.isdir(self.unzip_dirpath)
+        ):
+            return False
+
+        self._used_source = result.get("source")
+        self.state = UpdateState.UPDATED
+        self.log.info(f"{self.item_label}: Distributed by other process")
+        return True
+
+    def _store_lock_result(self):
+        try:
+            self._lock.write_result({
+                "source": self._used_source,
+                "checksum": self.checksum,
+                "checksum_algorithm": self.checksum_algorithm,
+                "distributed_dt": datetime.datetime.now().strftime(
+                    "%Y-%m-%d %H:%M:%S"
+                ),
+            })
+        except OSError:
+            self.log.warning(
+                f"{self.item_label}: Failed to store distribution result",
+                exc_info=True
+            )
+
+    def _distribute(self):
+        # Lock is released in '_post_distribute' after cleanup
+        self._acquire_lock()
+        if self._use_lock_result():
+            return
+
+        if not self._distribute_from_cache():
+            super()._distribute()
+
+        if self.state == UpdateState.UPDATED:
+            self._store_lock_result()
+
+    def _add_to_cache(self, filepath, downloader):
+        """Store downloaded archive to artifacts cache.
+
+        Args:
+            filepath (str): Path to downloaded and validated archive.
+            downloader (SourceDownloader): Downloader which received
+                the file.
+
+        Returns:
+            Union[str, None]: Path to archive in cache or None if archive
+                was not cached.
+        """
+
+        cache = self._artifact_cache
+        if (
+            cache is None
+            or not cache.enabled
+            or not self.checksum
+            or not downloader.cacheable
+        ):
+            return None
+
+        try:
+            return cache.add(filepath, self.checksum, self.checksum_algorithm)
+        except Exception:
+            self.log.warning(
+                f"{self.item_label}: Failed to store archive to cache",
+                exc_info=True
+            )
+        return None
+
+    def _remove_staging_dir(self):
+        staging_dirpath = self._staging_dirpath
+        self._staging_dirpath = None
+        if staging_dirpath and os.path.isdir(staging_dirpath):
+            self.log.debug(f"Cleaning {staging_dirpath}")
+            shutil.rmtree(staging_dirpath, ignore_errors=True)
+
+    def _compile_staging(self):
+        """Compile python sources in staging directory to bytecode.
+
+        Item is distributed even if compilation fails, sources are
+            compiled on import in that case.
+        """
+
+        workers = get_compile_workers()
+        if workers < 1:
+            return
+
+        try:
+            with self._phase_slot(DistributionPhase.COMPILE):
+                compile_dir(
+                    self._staging_dirpath,
+                    ddir=self.unzip_dirpath,
+                    workers=workers,
+                )
+        except Exception:
+            self.log.warning(
+                f"{self.item_label}: Failed to compile python sources",
+                exc_info=True
+            )
+
+    def _prepare_staging_manifest(self):
+        """Create manifest of staging directory if is not available.
+
+        Zip archives have manifest from their central directory, content
+            of other sources is hashed so it can be verified later.
+        """
+
+        if read_manifest(self._staging_dirpath) is not None:
+            return
+        try:
+            write_manifest(
+                self._staging_dirpath,
+                create_dir_manifest(self._staging_dirpath)
+            )
+        except Exception:
+            self.log.warning(
+                f"{self.item_label}: Failed to create manifest",
+                exc_info=True
+            )
 
-        except Exception as exc:
-            message = "Installation failed"
-            source_progress.set_failed(message)
-            if isinstance(exc, InstallerDistributionError):
-                self._installer_error = str(exc)
-            else:
-                self.log.warning(
-                    f"{self.item_label}: {message}",
-                    exc_info=True
-                )
-                self._installer_error = (
-                    f"Distribution of AYON launcher"
-                    " failed with unexpected reason."
-                )
+    def _add_staging_bytecode_to_manifest(self):
+        """Add compiled bytecode to manifest of staging directory.
 
-        self.state = (
-            UpdateState.UPDATED if success else UpdateState.UPDATE_FAILED
-        )
+        Compiled files are not validated against sources on import, so
+            they're verified the same way as other files.
+        """
 
-        self._used_source = source_data
-        if success or self._cleanup_on_fail:
-            downloader.cleanup(
-                source_data,
-                self.download_dirpath,
-                self.downloader_data
+        try:
+            add_compiled_files_to_manifest(self._staging_dirpath)
+        except Exception:
+            self.log.warning(
+                f"{self.item_label}: Failed to add bytecode to manifest",
+                exc_info=True
             )
 
-        return True
+    def verify_installed(self):
+        """Verify content of already distributed item.
 
+        Item is marked for distribution when content is corrupted.
 
-class DistributionItem(BaseDistributionItem):
-    """Distribution item with sources and target directories.
+        Returns:
+            bool: Content is valid or can't be verified.
+        """
 
-    Distribution item for addons and dependency packages. They have defined
-    unzip directory where the downloaded content is unzipped.
+        if self.state != UpdateState.UPDATED:
+            return True
 
-    Args:
-        unzip_dirpath (str): Path to directory where zip is downloaded.
-        download_dirpath (str): Path to directory where file is unzipped.
-        state (UpdateState): Initial state (UpdateState.UPDATED or
-            UpdateState.OUTDATED).
-        file_hash (str): Hash of file for validation.
-        factory (DownloadFactory): Downloaders factory object.
-        sources (List[SourceInfo]): Possible sources to receive the
-            distribution item.
-        downloader_data (Dict[str, Any]): More information for downloaders.
-        item_label (str): Label used in log outputs (and in UI).
-        logger (logging.Logger): Logger object.
-    """
+        invalid = verify_dir(self.unzip_dirpath)
+        if invalid is None:
+            self.log.debug(
+                f"{self.item_label}: Can't verify content without manifest"
+            )
+            return True
 
-    def __init__(self,unzip_dirpath, *args, **kwargs):
-        self.unzip_dirpath = unzip_dirpath
-        super().__init__(*args, **kwargs)
+        if not invalid:
+            return True
 
-    def _pre_source_process(self):
-        super()._pre_source_process()
-        unzip_dirpath = self.unzip_dirpath
+        self.log.warning(
+            f"{self.item_label}: {len(invalid)} files are missing or"
+            f" corrupted (e.g. '{invalid[0]}'), distributing again"
+        )
+        self._reuse_lock_result = False
+        self.state = UpdateState.OUTDATED
+        self._need_distribution = True
+        return False
+
+    def _commit_staging(self):
+        """Replace unzip directory with staging directory.
 
-        # Remove directory if exists
-        if os.path.isdir(unzip_dirpath):
-            self.log.debug(f"Cleaning {unzip_dirpath}")
-            shutil.rmtree(unzip_dirpath)
+        Python sources are compiled before the replacement. Previous
+            content of unzip directory is removed in background.
+        """
+
+        self._compile_staging()
+        verify_enabled = is_verify_installed_enabled()
+        if verify_enabled:
+            self._prepare_staging_manifest()
+            self._add_staging_bytecode_to_manifest()
+        trash_dirpath = replace_dir(self._staging_dirpath, self.unzip_dirpath)
+        self._staging_dirpath = None
+        if verify_enabled:
+            try:
+                update_verify_cache(self.unzip_dirpath)
+            except Exception:
+                self.log.warning(
+                    f"{self.item_label}: Failed to store verified state",
+                    exc_info=True
+                )
+        if trash_dirpath:
+            self.log.debug(
+                f"{self.item_label}: Removing previous content"
+                f" {trash_dirpath} in background"
+            )
+            remove_dir_in_background(trash_dirpath)
 
-        # Create directory
-        os.makedirs(unzip_dirpath)
+    def _pre_source_process(self):
+        super()._pre_source_process()
+        # Staging of previous source
+        self._remove_staging_dir()
+        self._staging_dirpath = get_sibling_dirpath(
+            self.unzip_dirpath, "staging", unique=True
+        )
+        os.makedirs(self._staging_dirpath)
 
     def _post_source_process(
         self, filepath, source_data, source_progress, downloader
     ):
+        cached_filepath = None
+        if filepath:
+            cached_filepath = self._add_to_cache(filepath, downloader)
+
         source_progress.set_unzip_started()
         try:
-            downloader.unzip(filepath, self.unzip_dirpath)
+            with self._phase_slot(DistributionPhase.EXTRACT):
+                if cached_filepath:
+                    # Keep archive in cache
+                    self._extract_archive(cached_filepath, source_progress)
+                else:
+                    self._extract_archive(
+                        filepath, source_progress, downloader
+                    )
+            self._commit_staging()
         except Exception:
             message = "Couldn't unzip source file"
             source_progress.set_failed(message)
@@ -862,13 +1755,19 @@ class DistributionItem(BaseDistributionItem):
         )
 
     def _post_distribute(self):
-        if (
-            self.state != UpdateState.UPDATED
-            and self.unzip_dirpath
-            and os.path.isdir(self.unzip_dirpath)
-        ):
-            self.log.debug(f"Cleaning {self.unzip_dirpath}")
-            shutil.rmtree(self.unzip_dirpath)
+        try:
+            # Previous content of unzip directory is kept on failure
+            self._remove_staging_dir()
+            # Download directory is kept on failure so download can
+            #   be resumed
+            if (
+                self.state == UpdateState.UPDATED
+                and self._own_download_dir
+                and os.path.isdir(self.download_dirpath)
+            ):
+                shutil.rmtree(self.download_dirpath, ignore_errors=True)
+        finally:
+            self._lock.release()
 
 
 class AyonDistribution:
@@ -900,6 +1799,10 @@ class AyonDistribution:
             If not passed, 'is_dev_mode_enabled' is used as default value.
         skip_installer_dist (Optional[bool]): Skip installer distribution. This
             is for testing purposes and for running from code.
+        artifact_cache (Optional[ArtifactCache]): Cache of downloaded
+            archives. Default cache in AYON appdirs is used if not passed.
+        metadata_store (Optional[MetadataStore]): Store of distribution
+            metadata. Default store in AYON appdirs is used if not passed.
     """
 
     def __init__(
@@ -916,17 +1819,27 @@ class AyonDistribution:
         use_dev=None,
         active_user=None,
         skip_installer_dist=False,
+        artifact_cache=None,
+        metadata_store=None,
     ):
         self._log = None
 
         self._dist_started = False
         self._dist_finished = False
+        self._event_hub = DistributionEventHub()
 
         self._addons_dirpath = addon_dirpath or get_addons_dir()
         self._dependency_dirpath = dependency_dirpath or get_dependencies_dir()
         self._dist_factory = (
             dist_factory or get_default_download_factory()
         )
+        if artifact_cache is None:
+            artifact_cache = ArtifactCache()
+        self._artifact_cache = artifact_cache
+        if metadata_store is None:
+            metadata_store = get_metadata_store()
+        self._metadata_store = metadata_store
+        self._metadata_mirrored = False
 
         if bundle_name is NOT_SET:
             bundle_name = os.environ.get("AYON_BUNDLE_NAME", NOT_SET)
@@ -978,11 +1891,86 @@ class AyonDistribution:
         # Final bundle that will be used
         self._bundle = NOT_SET
 
+    @staticmethod
+    def _fetch_active_user():
+        return ayon_api.get_user()["name"]
+
+    @staticmethod
+    def _fetch_bundles_info():
+        return ayon_api.get_bundles()
+
+    @staticmethod
+    def _fetch_addons_info():
+        return ayon_api.get_addons_info(details=True)["addons"]
+
+    @staticmethod
+    def _fetch_dependency_packages_info():
+        return ayon_api.get_dependency_packages()["packages"]
+
+    @staticmethod
+    def _fetch_installers_info():
+        return ayon_api.get_installers()["installers"]
+
+    def _need_active_user(self):
+        if self._use_dev is not None:
+            return self._use_dev
+        # Specific bundle may be dev bundle
+        return self._bundle_name is not NOT_SET or is_dev_mode_enabled()
+
+    def prefetch_server_data(self, max_workers=None):
+        """Request missing server data concurrently.
+
+        Properties like 'bundles_info' or 'addons_info' request data from
+        server on first access one after another. Prefetch sends all
+        requests at once, so boot does not wait for each round trip.
+
+        Failed requests are ignored here, data are requested again when
+        related property is accessed, so the error is raised there.
+
+        Args:
+            max_workers (Optional[int]): Maximum number of concurrent
+                requests.
+        """
+
+        fetch_funcs = {}
+        if self._bundles_info is NOT_SET:
+            fetch_funcs["_bundles_info"] = self._fetch_bundles_info
+        if self._addons_info is NOT_SET:
+            fetch_funcs["_addons_info"] = self._fetch_addons_info
+        if self._dependency_packages_info is NOT_SET:
+            fetch_funcs["_dependency_packages_info"] = (
+                self._fetch_dependency_packages_info
+            )
+        if self._installers_info is NOT_SET and not self._skip_installer_dist:
+            fetch_funcs["_installers_info"] = self._fetch_installers_info
+        if self._active_user is None and self._need_active_user():
+            fetch_funcs["_active_user"] = self._fetch_active_user
+
+        if not fetch_funcs:
+            return
+
+        with ThreadPoolExecutor(
+            max_workers=max_workers or len(fetch_funcs),
+            thread_name_prefix="ayon_prefetch"
+        ) as executor:
+            futures = {
+                attr_name: executor.submit(func)
+                for attr_name, func in fetch_funcs.items()
+            }
+
+        for attr_name, future in futures.items():
+            exc = future.exception()
+            if exc is not None:
+                self.log.debug(
+                    f"Prefetch of '{attr_name}' failed", exc_info=exc
+                )
+                continue
+            setattr(self, attr_name, future.result())
+
     @property
     def active_user(self):
         if self._active_user is None:
-            user = ayon_api.get_user()
-            self._active_user = user["name"]
+            self._active_user = self._fetch_active_user()
         return self._active_user
 
     @property
@@ -1052,7 +2040,7 @@ class AyonDistribution:
         """
 
         if self._bundles_info is NOT_SET:
-            self._bundles_info = ayon_api.get_bundles()
+            self._bundles_info = self._fetch_bundles_info()
         return self._bundles_info
 
     @property
@@ -1171,7 +2159,7 @@ class AyonDistribution:
         """
 
         if self._installers_info is NOT_SET:
-            self._installers_info = ayon_api.get_installers()["installers"]
+            self._installers_info = self._fetch_installers_info()
         return self._installers_info
 
     @property
@@ -1356,6 +2344,7 @@ class AyonDistribution:
             "type": "installer",
             "version": installer_item.version,
             "filename": installer_item.filename,
+            "size": installer_item.size,
         }
 
         tmp_used = False
@@ -1377,6 +2366,7 @@ class AyonDistribution:
                 downloader_data,
                 f"Installer {installer_item.version}"
             )
+            dist_item.set_event_hub(self._event_hub)
             dist_item.distribute()
             self._installer_executable = dist_item.executable
             if dist_item.installer_error is not None:
@@ -1420,8 +2410,7 @@ class AyonDistribution:
         """
 
         if self._addons_info is NOT_SET:
-            server_info = ayon_api.get_addons_info(details=True)
-            self._addons_info = server_info["addons"]
+            self._addons_info = self._fetch_addons_info()
         return self._addons_info
 
     @property
@@ -1457,7 +2446,8 @@ class AyonDistribution:
 
         if self._dependency_packages_info is NOT_SET:
             self._dependency_packages_info = (
-                ayon_api.get_dependency_packages())["packages"]
+                self._fetch_dependency_packages_info()
+            )
         return self._dependency_packages_info
 
     @property
@@ -1512,6 +2502,102 @@ class AyonDistribution:
         self._staging_bundle = staging_bundle
         self._dev_bundle = dev_bundle
 
+    def _get_peer_sources(self, checksum, checksum_algorithm, filename=None):
+        """Sources from machines in local network sharing artifacts cache.
+
+        Peer source is used as first source so server is asked only when
+        none of peers has the archive.
+
+        Args:
+            checksum (Union[str, None]): Checksum of archive.
+            checksum_algorithm (str): Algorithm of checksum.
+            filename (Optional[str]): Filename of archive.
+
+        Returns:
+            list[PeerSourceInfo]: Peer sources.
+        """
+
+        if not checksum or not get_distribution_peers():
+            return []
+        return [
+            PeerSourceInfo(
+                type=UrlType.PEER.value,
+                checksum=checksum,
+                checksum_algorithm=checksum_algorithm,
+                filename=filename,
+            )
+        ]
+
+    def _get_delta_base_dirpath(
+        self, addon_name, addon_version, addons_metadata
+    ):
+        """Directory of last distributed version of addon.
+
+        Args:
+            addon_name (str): Name of addon.
+            addon_version (str): Version which will be distributed.
+            addons_metadata (dict[str, Any]): Addons metadata.
+
+        Returns:
+            Union[str, None]: Path to directory with previous version.
+        """
+
+        versions_metadata = addons_metadata.get(addon_name) or {}
+        return self._get_last_distributed_dirpath([
+            (
+                os.path.join(self._addons_dirpath, f"{addon_name}_{version}"),
+                version_data
+            )
+            for version, version_data in versions_metadata.items()
+            if version != addon_version
+        ])
+
+    def _get_dependency_delta_base_dirpath(self, package_filename, metadata):
+        """Directory of last distributed dependency package.
+
+        Dependency packages are regenerated when requirements of any addon
+        change, so most of the content is same as in previous package.
+
+        Delta update of dependency package is opt-in. Packages have checksum
+        which can't be validated when only changed members are received,
+        so delta is used only with 'AYON_DELTA_UPDATES' set to '1'.
+
+        Args:
+            package_filename (str): Filename of package which will be
+                distributed.
+            metadata (dict[str, Any]): Dependency packages metadata.
+
+        Returns:
+            Union[str, None]: Path to directory with previous package.
+        """
+
+        return self._get_last_distributed_dirpath([
+            (os.path.join(self._dependency_dirpath, filename), package_data)
+            for filename, package_data in metadata.items()
+            if filename != package_filename
+        ])
+
+    def _get_last_distributed_dirpath(self, candidates):
+        """Last distributed directory which still exists.
+
+        Args:
+            candidates (list[tuple[str, dict[str, Any]]]): Directory paths
+                with their metadata.
+
+        Returns:
+            Union[str, None]: Path to directory.
+        """
+
+        existing = [
+            (data.get("distributed_dt") or "", dirpath)
+            for dirpath, data in candidates
+            if os.path.isdir(dirpath)
+        ]
+        if not existing:
+            return None
+        # Last distributed version is most likely the most similar
+        return max(existing)[1]
+
     def _prepare_current_addon_dist_items(self):
         addons_metadata = self.get_addons_metadata()
         output = []
@@ -1562,6 +2648,12 @@ class AyonDistribution:
             else:
                 state = UpdateState.OUTDATED
 
+            delta_base_dirpath = None
+            if state == UpdateState.OUTDATED:
+                delta_base_dirpath = self._get_delta_base_dirpath(
+                    addon_name, addon_version, addons_metadata
+                )
+
             downloader_data = {
                 "type": "addon",
                 "name": addon_name,
@@ -1575,10 +2667,19 @@ class AyonDistribution:
                 checksum=addon_version_item.checksum,
                 checksum_algorithm=addon_version_item.checksum_algorithm,
                 factory=self._dist_factory,
-                sources=list(addon_version_item.sources),
+                sources=(
+                    self._get_peer_sources(
+                        addon_version_item.checksum,
+                        addon_version_item.checksum_algorithm
+                    )
+                    + list(addon_version_item.sources)
+                ),
                 downloader_data=downloader_data,
                 item_label=full_name,
-                logger=self.log
+                logger=self.log,
+                artifact_cache=self._artifact_cache,
+                zip_import=is_zip_import_enabled(addon_name),
+                delta_base_dirpath=delta_base_dirpath,
             )
             output.append({
                 "dist_item": dist_item,
@@ -1598,15 +2699,23 @@ class AyonDistribution:
         downloader_data = {
             "type": "dependency_package",
             "name": package.filename,
-            "platform": package.platform_name
+            "platform": package.platform_name,
+            "size": package.size,
         }
         zip_dir = package_dir = os.path.join(
             self._dependency_dirpath, package.filename
         )
         self.log.debug(f"Checking {package.filename} in {package_dir}")
 
+        delta_base_dirpath = None
         if not os.path.isdir(package_dir) or package.filename not in metadata:
             state = UpdateState.OUTDATED
+            # Server always provides checksum of dependency package, delta
+            #   update has to be enabled explicitly
+            if is_delta_update_enabled(bool(package.checksum)):
+                delta_base_dirpath = self._get_dependency_delta_base_dirpath(
+                    package.filename, metadata
+                )
         else:
             state = UpdateState.UPDATED
 
@@ -1617,10 +2726,21 @@ class AyonDistribution:
             checksum=package.checksum,
             checksum_algorithm=package.checksum_algorithm,
             factory=self._dist_factory,
-            sources=package.sources,
+            sources=(
+                self._get_peer_sources(
+                    package.checksum,
+                    package.checksum_algorithm,
+                    package.filename
+                )
+                + list(package.sources)
+            ),
             downloader_data=downloader_data,
             item_label=os.path.splitext(package.filename)[0],
             logger=self.log,
+            # Dependency package is the biggest item, start it first
+            priority=1,
+            artifact_cache=self._artifact_cache,
+            delta_base_dirpath=delta_base_dirpath,
         )
 
     def get_addon_dist_items(self):
@@ -1677,8 +2797,11 @@ class AyonDistribution:
         Metadata contain information about distributed packages, used source,
         expected file hash and time when file was distributed.
 
+        Metadata are stored in metadata store, the file is kept in sync
+        for other machines and older versions of AYON launcher.
+
         Returns:
-            str: Path to a file where dependency package metadata are stored.
+            str: Path to a file where dependency package metadata were stored.
         """
 
         return os.path.join(self._dependency_dirpath, "dependency.json")
@@ -1689,12 +2812,29 @@ class AyonDistribution:
         Metadata contain information about distributed addons, used sources,
         expected file hashes and time when files were distributed.
 
+        Metadata are stored in metadata store, the file is kept in sync
+        for other machines and older versions of AYON launcher.
+
         Returns:
-            str: Path to a file where addons metadata are stored.
+            str: Path to a file where addons metadata were stored.
         """
 
         return os.path.join(self._addons_dirpath, "addons.json")
 
+    def get_import_index_filepath(self):
+        """Path to index of top-level python modules in addons.
+
+        Index file is unique for python paths of the bundle.
+
+        Returns:
+            str: Path to a file where import index is stored.
+        """
+
+        return os.path.join(
+            self._addons_dirpath,
+            get_import_index_filename(self._get_import_index_dirpaths())
+        )
+
     def read_metadata_file(self, filepath, default_value=None):
         """Read json file from path.
 
@@ -1739,32 +2879,87 @@ class AyonDistribution:
         with open(filepath, "w") as stream:
             json.dump(data, stream, indent=4)
 
+    def _get_metadata_root(self, dirpath):
+        return os.path.normpath(os.path.abspath(dirpath))
+
+    def _get_metadata_store(self):
+        """Metadata store mirroring metadata json files.
+
+        Json files next to distributed items are used by other machines
+            sharing the directories and by older versions of AYON launcher.
+
+        Returns:
+            MetadataStore: Metadata store.
+        """
+
+        store = self._metadata_store
+        if self._metadata_mirrored:
+            return store
+
+        store.mirror_items(
+            self._get_metadata_root(self._addons_dirpath),
+            ADDON_METADATA_KIND,
+            self.get_addons_metadata_filepath(),
+            lambda data: [
+                (addon_name, addon_version, version_data)
+                for addon_name, versions in data.items()
+                for addon_version, version_data in versions.items()
+            ],
+            lambda items: items
+        )
+        store.mirror_items(
+            self._get_metadata_root(self._dependency_dirpath),
+            DEPENDENCY_METADATA_KIND,
+            self.get_dependency_metadata_filepath(),
+            lambda data: [
+                (package_name, "", package_data)
+                for package_name, package_data in data.items()
+            ],
+            lambda items: {
+                package_name: versions[""]
+                for package_name, versions in items.items()
+            }
+        )
+        self._metadata_mirrored = True
+        return store
+
     def get_dependency_metadata(self):
-        filepath = self.get_dependency_metadata_filepath()
-        return self.read_metadata_file(filepath, {})
+        items = self._get_metadata_store().get_items(
+            self._get_metadata_root(self._dependency_dirpath),
+            DEPENDENCY_METADATA_KIND,
+        )
+        return {
+            package_name: versions[""]
+            for package_name, versions in items.items()
+        }
 
     def update_dependency_metadata(self, package_name, data):
-        dependency_metadata = self.get_dependency_metadata()
-        dependency_metadata[package_name] = data
-        filepath = self.get_dependency_metadata_filepath()
-        self.save_metadata_file(filepath, dependency_metadata)
+        self._get_metadata_store().set_items(
+            self._get_metadata_root(self._dependency_dirpath),
+            DEPENDENCY_METADATA_KIND,
+            [(package_name, "", data)]
+        )
 
     def get_addons_metadata(self):
-        filepath = self.get_addons_metadata_filepath()
-        return self.read_metadata_file(filepath, {})
+        return self._get_metadata_store().get_items(
+            self._get_metadata_root(self._addons_dirpath),
+            ADDON_METADATA_KIND,
+        )
 
     def update_addons_metadata(self, addons_information):
         if not addons_information:
             return
-        addons_metadata = self.get_addons_metadata()
-        for addon_name, version_value in addons_information.items():
-            if addon_name not in addons_metadata:
-                addons_metadata[addon_name] = {}
-            for addon_version, version_data in version_value.items():
-                addons_metadata[addon_name][addon_version] = version_data
-
-        filepath = self.get_addons_metadata_filepath()
-        self.save_metadata_file(filepath, addons_metadata)
+        # Only changed versions are written in single transaction, so
+        #   changes of other processes are not overwritten
+        self._get_metadata_store().set_items(
+            self._get_metadata_root(self._addons_dirpath),
+            ADDON_METADATA_KIND,
+            [
+                (addon_name, addon_version, version_data)
+                for addon_name, version_value in addons_information.items()
+                for addon_version, version_data in version_value.items()
+            ]
+        )
 
     def finish_distribution(self):
         """Store metadata about distributed items."""
@@ -1814,6 +3009,17 @@ class AyonDistribution:
 
         self.update_addons_metadata(addons_info)
 
+        if is_import_index_enabled():
+            try:
+                update_import_index(
+                    self.get_import_index_filepath(),
+                    self._get_import_index_dirpaths()
+                )
+            except Exception:
+                self.log.warning(
+                    "Failed to update import index", exc_info=True
+                )
+
     def get_all_distribution_items(self):
         """Distribution items required by server.
 
@@ -1854,7 +3060,22 @@ class AyonDistribution:
                 return True
         return False
 
-    def distribute(self, threaded=False):
+    def add_event_callback(self, callback):
+        """Register callback called with distribution events.
+
+        Callback is called from distribution worker threads, see
+        'DistributionEventTopic' for available topics.
+
+        Args:
+            callback (Callable[[DistributionEvent], None]): Callback.
+        """
+
+        self._event_hub.add_callback(callback)
+
+    def remove_event_callback(self, callback):
+        self._event_hub.remove_callback(callback)
+
+    def distribute(self, threaded=False, max_workers=None):
         """Distribute all missing items.
 
         Method will try to distribute all items that are required by server.
@@ -1862,8 +3083,14 @@ class AyonDistribution:
         This method does not handle failed items. To validate the result call
         'validate_distribution' when this method finishes.
 
+        Progress of distribution is reported as events to callbacks
+        registered with 'add_event_callback'.
+
         Args:
-            threaded (bool): Distribute items in threads.
+            threaded (bool): Distribute items in parallel using bounded
+                pool of worker threads.
+            max_workers (Optional[int]): Maximum number of items distributed
+                at the same time. Used only when 'threaded' is enabled.
         """
 
         if self._dist_started:
@@ -1875,21 +3102,98 @@ class AyonDistribution:
                 self.distribute_installer()
             return
 
-        threads = collections.deque()
-        for item in self.get_all_distribution_items():
+        # Leftovers of previous interrupted distributions
+        with trace_span("cleanup stale directories"):
+            for dirpath in (self._addons_dirpath, self._dependency_dirpath):
+                try:
+                    cleanup_stale_dirs(dirpath)
+                except Exception:
+                    self.log.warning(
+                        f"Failed to cleanup {dirpath}", exc_info=True
+                    )
+
+        items = self.get_all_distribution_items()
+        if is_verify_installed_enabled():
+            with trace_span("verify installed"):
+                self._verify_installed(items)
+
+        for item in items:
+            item.set_event_hub(self._event_hub)
+
+        self._event_hub.emit(
+            DistributionEventTopic.DISTRIBUTION_STARTED,
+            items=[
+                item.item_label
+                for item in items
+                if item.need_distribution
+            ]
+        )
+        try:
             if threaded:
-                threads.append(threading.Thread(target=item.distribute))
+                scheduler = DistributionScheduler(
+                    max_workers=max_workers, logger=self.log
+                )
+                scheduler.run(items)
             else:
-                item.distribute()
+                for item in items:
+                    item.distribute()
 
-        while threads:
-            thread = threads.popleft()
-            if thread.is_alive():
-                threads.append(thread)
-            else:
-                thread.join()
+            self.finish_distribution()
+
+        finally:
+            self._event_hub.emit(
+                DistributionEventTopic.DISTRIBUTION_FINISHED,
+                failed=[
+                    item.item_label
+                    for item in items
+                    if item.state != UpdateState.UPDATED
+                ]
+            )
+
+    def _verify_installed(self, items):
+        """Verify content of already distributed items in parallel.
+
+        Corrupted items are distributed again.
+
+        Args:
+            items (list[DistributionItem]): Distribution items.
+        """
 
-        self.finish_distribution()
+        def _verify(item):
+            try:
+                item.verify_installed()
+            except Exception:
+                self.log.warning(
+                    f"{item.item_label}: Verification failed",
+                    exc_info=True
+                )
+
+        with ThreadPoolExecutor(
+            max_workers=min(8, max(1, len(items))),
+            thread_name_prefix="ayon_verify"
+        ) as executor:
+            list(executor.map(_verify, items))
+
+    def get_boot_snapshot_data(self):
+        """Server data which can be stored to boot snapshot.
+
+        Data can be passed to '__init__' of next distribution, so server
+        does not have to be asked for them again.
+
+        Returns:
+            dict[str, Any]: Server data by '__init__' argument names.
+        """
+
+        output = {
+            "bundles_info": self.bundles_info,
+            "addons_info": self.addons_info,
+            "dependency_packages_info": self.dependency_packages_info,
+            "active_user": self.active_user,
+        }
+        # Installers are not requested when installer distribution is skipped
+        if self._installers_info is not NOT_SET:
+            output["installers_info"] = self._installers_info
+        return output
 
     def validate_distribution(self):
         """Check if all required distribution items are distributed.
@@ -1945,17 +3249,64 @@ class AyonDistribution:
                 output.append(runtime_dir)
         return output
 
-    def get_python_paths(self):
+    def get_python_paths(self, include_addons=True):
         """Get all paths to python packages that should be added to python.
 
         These paths lead to addon directories and python dependencies in
         dependency package.
 
+        Args:
+            include_addons (Optional[bool]): Include paths to addons. Paths
+                to addons don't have to be in 'sys.path' when import
+                finder is installed.
+
         Returns:
             List[str]: Paths that should be added to 'sys.path' and
                 'PYTHONPATH'.
         """
 
+        output = []
+        if include_addons:
+            output.extend(self._get_addons_python_paths())
+        output.extend(self._get_dependencies_python_paths())
+        return output
+
+    def install_import_finder(self):
+        """Install import finder resolving modules of addons.
+
+        Finder uses index of top-level modules built on distribution. It
+        resolves modules in the same order as if paths from
+        'get_python_paths' and then 'get_sys_paths' were inserted to
+        start of 'sys.path' one by one, so runtime and dependency
+        package modules are not shadowed by addons.
+
+        Returns:
+            bool: Finder was installed. Paths to addons must be added
+                to 'sys.path' if finder was not installed.
+        """
+
+        if not is_import_index_enabled():
+            return False
+
+        index = load_import_index(
+            self.get_import_index_filepath(),
+            self._get_import_index_dirpaths()
+        )
+        if index is None:
+            return False
+        install_import_finder(index)
+        return True
+
+    def _get_import_index_dirpaths(self):
+        # Paths from 'get_python_paths' and then 'get_sys_paths' are
+        #   inserted to 'sys.path' one by one, so the last has the highest
+        #   priority. Finder is used before 'sys.path', so the runtime
+        #   paths must be in index too, to keep their priority over addons.
+        output = list(reversed(self.get_sys_paths()))
+        output.extend(reversed(self.get_python_paths()))
+        return output
+
+    def _get_addons_python_paths(self):
         output = []
         for item in self.get_addon_dist_items():
             dist_item = item["dist_item"]
@@ -1963,10 +3314,13 @@ class AyonDistribution:
                 continue
             unzip_dirpath = dist_item.unzip_dirpath
             if unzip_dirpath and os.path.exists(unzip_dirpath):
-                output.append(unzip_dirpath)
+                output.append(dist_item.python_path)
 
         output.extend(self._get_dev_sys_paths())
+        return output
 
+    def _get_dependencies_python_paths(self):
+        output = []
         dependency_dist_item = self.get_dependency_dist_item()
         if dependency_dist_item is not None:
             dependencies_dir = None
@@ -10,6 +10,7 @@ class UrlType(Enum):
     GIT = "git"
     FILESYSTEM = "filesystem"
     SERVER = "server"
+    PEER = "peer"
 
 
 @attr.s
@@ -42,6 +43,14 @@ class ServerSourceInfo(SourceInfo):
     path = attr.ib(default=None)
 
 
+@attr.s
+class PeerSourceInfo(SourceInfo):
+    """Source from artifacts cache of other machine in local network."""
+    checksum = attr.ib(default=None)
+    checksum_algorithm = attr.ib(default=None)
+    filename = attr.ib(default=None)
+
+
 def convert_source(source):
     """Create source object from data information.
 
@@ -78,6 +87,14 @@ def convert_source(source):
             path=source.get("path")
         )
 
+    if source_type == UrlType.PEER.value:
+        return PeerSourceInfo(
+            type=source_type,
+            checksum=source["checksum"],
+            checksum_algorithm=source.get("checksum_algorithm", "sha256"),
+            filename=source.get("filename")
+        )
+
 
 def prepare_sources(src_sources, title):
     sources = []
@@ -209,6 +226,7 @@ class DependencyItem(object):
     unknown_sources = attr.ib(default=attr.Factory(list))
     source_addons = attr.ib(default=attr.Factory(dict))
     python_modules = attr.ib(default=attr.Factory(dict))
+    size = attr.ib(default=None)
 
     @classmethod
     def from_dict(cls, package):
@@ -230,7 +248,8 @@ class DependencyItem(object):
             # Backwards compatibility
             checksum_algorithm=package.get("checksumAlgorithm", "sha256"),
             source_addons=package["sourceAddons"],
-            python_modules=package["pythonModules"]
+            python_modules=package["pythonModules"],
+            size=package.get("size"),
         )
 
 
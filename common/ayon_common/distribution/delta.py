@@ -0,0 +1,333 @@
+"""Delta update of addons and dependency packages.
+
+Extracted zip archive has manifest with size and CRC32 of each file,
+which are also available in central directory of zip archive. New
+version of addon or dependency package can reuse unchanged files of
+previously distributed version using hardlinks (or copies) and only
+changed files have to be received.
+
+Members of zip archive are compressed separately, so unchanged file has
+the same bytes in new archive even if its position changed. Changed
+members are found using central directory, so rolling checksum over
+whole archive is not needed.
+
+Central directory and changed members of remote zip archive are
+downloaded using range requests, so server does not have to support
+anything else. Content of received members is validated by CRC32 from
+central directory, reused files of previous version are validated by
+CRC32 before they're linked. Checksum of whole archive can't be validated
+because whole archive is not downloaded, so delta is not used for items
+with checksum unless it's explicitly enabled. Dependency packages always
+have checksum, so their delta update is opt-in using 'AYON_DELTA_UPDATES'
+environment variable set to '1'.
+"""
+
+import os
+import json
+import shutil
+import zipfile
+
+from ayon_common.checksum import calculate_files_checksums
+
+MANIFEST_FILENAME = ".ayon_manifest.json"
+MANIFEST_VERSION = 1
+# Delta is not used if changed members are bigger than this part
+#   of archive
+DEFAULT_MAX_DELTA_RATIO = 0.5
+# Smaller archives are downloaded whole, range requests would not
+#   save much
+MIN_DELTA_ARCHIVE_SIZE = 4 * 1024 * 1024
+# Changed members closer than this are downloaded by single request
+MAX_RANGE_GAP = 16 * 1024
+# Maximum size of single request with changed members
+MAX_RANGE_SIZE = 16 * 1024 * 1024
+
+
+def is_delta_update_enabled(has_checksum=False):
+    """Items can be updated using delta from previous version.
+
+    Can be disabled with 'AYON_DELTA_UPDATES' environment variable set
+    to '0'. Items with checksum are updated using delta only if the
+    variable is set to '1', files are validated only by CRC32.
+
+    Args:
+        has_checksum (Optional[bool]): Item has checksum of whole archive.
+
+    Returns:
+        bool: Delta update is enabled.
+    """
+
+    value = os.getenv("AYON_DELTA_UPDATES")
+    if has_checksum:
+        return value == "1"
+    return value != "0"
+
+
+def get_zip_manifest(zip_file):
+    """Manifest of files in zip archive.
+
+    Args:
+        zip_file (zipfile.ZipFile): Opened zip archive.
+
+    Returns:
+        dict[str, Any]: Manifest data.
+    """
+
+    return {
+        "version": MANIFEST_VERSION,
+        "files": {
+            member.filename: {
+                "size": member.file_size,
+                "crc32": member.CRC,
+            }
+            for member in zip_file.infolist()
+            if not member.is_dir()
+        }
+    }
+
+
+def write_manifest(dirpath, manifest):
+    """Store manifest to directory with extracted content.
+
+    Args:
+        dirpath (str): Directory with extracted content.
+        manifest (dict[str, Any]): Manifest data.
+    """
+
+    with open(os.path.join(dirpath, MANIFEST_FILENAME), "w") as stream:
+        json.dump(manifest, stream)
+
+
+def create_dir_manifest(dirpath):
+    """Manifest of files in directory.
+
+    Used for content which was not extracted from zip archive. Bytecode
+    caches and AYON metadata files are not included.
+
+    Args:
+        dirpath (str): Directory with extracted content.
+
+    Returns:
+        dict[str, Any]: Manifest data.
+    """
+
+    filepaths = []
+    for root, dirnames, filenames in os.walk(dirpath):
+        dirnames[:] = [
+            dirname
+            for dirname in dirnames
+            if dirname != "__pycache__"
+        ]
+        for filename in filenames:
+            if root == dirpath and filename.startswith(".ayon_"):
+                continue
+            filepaths.append(os.path.join(root, filename))
+
+    checksums = calculate_files_checksums(filepaths, "crc32")
+    files = {}
+    for filepath in filepaths:
+        relpath = os.path.relpath(filepath, dirpath).replace("\\", "/")
+        files[relpath] = {
+            "size": os.path.getsize(filepath),
+            "crc32": int(checksums[filepath], 16),
+        }
+    return {"version": MANIFEST_VERSION, "files": files}
+
+
+def read_zip_manifest(filepath):
+    """Manifest of zip archive file.
+
+    Args:
+        filepath (str): Path to zip archive.
+
+    Returns:
+        dict[str, Any]: Manifest data.
+    """
+
+    with zipfile.ZipFile(filepath) as zip_file:
+        return get_zip_manifest(zip_file)
+
+
+def read_manifest(dirpath):
+    """Read manifest of extracted content.
+
+    Args:
+        dirpath (str): Directory with extracted content.
+
+    Returns:
+        Union[dict[str, Any], None]: Manifest data or None if is
+            not available.
+    """
+
+    filepath = os.path.join(dirpath, MANIFEST_FILENAME)
+    if not os.path.exists(filepath):
+        return None
+    try:
+        with open(filepath, "r") as stream:
+            manifest = json.load(stream)
+    except (OSError, ValueError):
+        return None
+    if manifest.get("version") != MANIFEST_VERSION:
+        return None
+    return manifest
+
+
+def _is_safe_member_path(filename):
+    parts = filename.replace("\\", "/").split("/")
+    return not (
+        os.path.isabs(filename)
+        or ":" in parts[0]
+        or ".." in parts
+    )
+
+
+def _is_member_unchanged(member, base_dirpath, base_files):
+    base_info = base_files.get(member.filename)
+    if (
+        base_info is None
+        or base_info["size"] != member.file_size
+        or base_info["crc32"] != member.CRC
+        or not _is_safe_member_path(member.filename)
+    ):
+        return False
+
+    # Quick check that file was not changed or removed
+    base_path = os.path.join(base_dirpath, member.filename)
+    try:
+        return os.path.getsize(base_path) == member.file_size
+    except OSError:
+        return False
+
+
+def _link_or_copy(src_path, dst_path):
+    try:
+        os.link(src_path, dst_path)
+    except OSError:
+        shutil.copyfile(src_path, dst_path)
+
+
+def get_member_ranges(zip_file, members):
+    """Byte ranges of members in archive.
+
+    Range of member contains its local header and compressed data. Close
+    ranges are merged, so their members are downloaded by single request.
+
+    Args:
+        zip_file (zipfile.ZipFile): Opened zip archive.
+        members (list[zipfile.ZipInfo]): Members of archive.
+
+    Returns:
+        list[tuple[int, int, list[zipfile.ZipInfo]]]: Start and end
+            (exclusive) of ranges with their members sorted by position.
+    """
+
+    # Member ends where next member starts, last member ends where
+    #   central directory starts
+    offsets = sorted(member.header_offset for member in zip_file.infolist())
+    archive_end = getattr(zip_file, "start_dir", None)
+    if archive_end is None:
+        archive_end = offsets[-1] if offsets else 0
+    next_offsets = dict(zip(offsets, offsets[1:] + [archive_end]))
+
+    ranges = []
+    for member in sorted(members, key=lambda item: item.header_offset):
+        start = member.header_offset
+        end = max(start, next_offsets[start])
+        if ranges:
+            range_start, range_end, range_members = ranges[-1]
+            if (
+                start - range_end <= MAX_RANGE_GAP
+                and end - range_start <= MAX_RANGE_SIZE
+            ):
+                ranges[-1] = (range_start, end, range_members)
+                range_members.append(member)
+                continue
+        ranges.append((start, end, [member]))
+    return ranges
+
+
+def extract_zip_delta(
+    zip_file,
+    base_dirpath,
+    base_manifest,
+    dst_dirpath,
+    max_ratio=DEFAULT_MAX_DELTA_RATIO,
+    progress_callback=None,
+):
+    """Extract zip archive reusing unchanged files of previous version.
+
+    Args:
+        zip_file (zipfile.ZipFile): Opened zip archive of new version.
+        base_dirpath (str): Directory with previous version.
+        base_manifest (dict[str, Any]): Manifest of previous version.
+        dst_dirpath (str): Directory where new version is extracted.
+        max_ratio (Optional[float]): Delta is not used if compressed size
+            of changed members is bigger than this part of archive.
+        progress_callback (Optional[Callable[[int], None]]): Called
+            with size of each extracted or reused file.
+
+    Returns:
+        bool: Delta was applied. 'False' if delta is too big.
+    """
+
+    base_files = base_manifest["files"]
+    members = [
+        member
+        for member in zip_file.infolist()
+        if not member.is_dir()
+    ]
+    changed = []
+    candidates = []
+    for member in members:
+        if _is_member_unchanged(member, base_dirpath, base_files):
+            candidates.append(member)
+        else:
+            changed.append(member)
+
+    # Files of previous version may be modified in place, reuse only
+    #   files with matching content
+    checksums = calculate_files_checksums(
+        [
+            os.path.join(base_dirpath, member.filename)
+            for member in candidates
+        ],
+        "crc32"
+    )
+    unchanged = []
+    for member in candidates:
+        base_path = os.path.join(base_dirpath, member.filename)
+        if int(checksums[base_path], 16) == member.CRC:
+            unchanged.append(member)
+        else:
+            changed.append(member)
+
+    total_size = sum(member.compress_size for member in members)
+    changed_size = sum(member.compress_size for member in changed)
+    if total_size and changed_size > total_size * max_ratio:
+        return False
+
+    for member in unchanged:
+        dst_path = os.path.join(dst_dirpath, member.filename)
+        os.makedirs(os.path.dirname(dst_path), exist_ok=True)
+        _link_or_copy(os.path.join(base_dirpath, member.filename), dst_path)
+        if progress_callback is not None:
+            progress_callback(member.file_size)
+
+    # Download only ranges of changed members if file object of archive
+    #   supports it (e.g. 'HTTPRangeReader')
+    prefetch = getattr(zip_file.fp, "prefetch", None)
+    for start, end, range_members in get_member_ranges(zip_file, changed):
+        if prefetch is not None:
+            prefetch(start, end)
+        for member in range_members:
+            zip_file.extract(member, dst_dirpath)
+            if progress_callback is not None:
+                progress_callback(member.file_size)
+
+    # Empty directories
+    for member in zip_file.infolist():
+        if member.is_dir():
+            zip_file.extract(member, dst_dirpath)
+
+    write_manifest(dst_dirpath, get_zip_manifest(zip_file))
+    return True
@@ -1,20 +1,57 @@
 import os
+import re
+import time
 import logging
+import threading
 import platform
+import urllib.request
 from abc import ABCMeta, abstractmethod
 
 import ayon_api
 
-from ayon_common import extract_archive_file, validate_file_checksum
-
-from .file_handler import RemoteFileHandler
+from ayon_common import (
+    extract_archive_file,
+    get_archive_ext_and_type,
+    validate_file_checksum,
+    get_checksum_object,
+)
+
+from .file_handler import (
+    SEGMENTED_DOWNLOAD_MIN_SIZE,
+    RemoteFileHandler,
+    SegmentedFileDownload,
+)
 from .data_structures import UrlType
+from .peer import get_distribution_peers, get_artifact_url
+
+DEFAULT_DOWNLOAD_SEGMENTS = 4
+
+
+def get_download_segments():
+    """Number of concurrent range requests used to download big files.
+
+    Value can be changed with 'AYON_DOWNLOAD_SEGMENTS' environment
+    variable. Value '1' disables segmented downloads.
+
+    Returns:
+        int: Number of segments.
+    """
+
+    value = os.getenv("AYON_DOWNLOAD_SEGMENTS")
+    if value:
+        try:
+            return max(1, int(value))
+        except ValueError:
+            pass
+    return DEFAULT_DOWNLOAD_SEGMENTS
 
 
 class SourceDownloader(metaclass=ABCMeta):
     """Abstract class for source downloader."""
 
     log = logging.getLogger(__name__)
+    # Downloaded files can be stored to artifacts cache
+    cacheable = True
 
     @classmethod
     @abstractmethod
@@ -39,6 +76,42 @@ class SourceDownloader(metaclass=ABCMeta):
 
         pass
 
+    @classmethod
+    def download_with_checksum(
+        cls,
+        source,
+        destination_dir,
+        data,
+        transfer_progress,
+        checksum_algorithm
+    ):
+        """Download file and calculate checksum of received content.
+
+        Downloaders that can calculate checksum of content while it is
+        received should override this method, so the file does not have
+        to be read again for hash check. Default implementation only calls
+        'download' and does not calculate checksum.
+
+        Args:
+            source (dict): {type:"http", "url":"https://} ...}
+            destination_dir (str): local folder to unzip
+            data (dict): More information about download content. Always have
+                'type' key in.
+            transfer_progress (ayon_api.TransferProgress): Progress of
+                transferred (copy/download) content.
+            checksum_algorithm (Union[str, None]): Algorithm used for
+                checksum. Checksum is not calculated if is not set.
+
+        Returns:
+            tuple[str, Union[str, None]]: Local path to downloaded file and
+                checksum of received content if was calculated.
+        """
+
+        filepath = cls.download(
+            source, destination_dir, data, transfer_progress
+        )
+        return filepath, None
+
     @classmethod
     @abstractmethod
     def cleanup(cls, source, destination_dir, data):
@@ -51,37 +124,192 @@ class SourceDownloader(metaclass=ABCMeta):
         pass
 
     @classmethod
-    def check_hash(cls, filepath, checksum, checksum_algorithm="sha256"):
+    def get_stream_request(cls, source, data):
+        """Url and headers to download source as stream.
+
+        Downloaders which can download content from url should override
+        the method, so tar archives can be extracted while downloaded.
+
+        Args:
+            source (dict): Source information.
+            data (dict): More information about download content.
+
+        Returns:
+            Union[tuple[str, Union[dict[str, str], None], str], None]: Url,
+                request headers and filename of source, or None if source
+                can't be downloaded as stream.
+        """
+
+        return None
+
+    @classmethod
+    def stream_extract(
+        cls,
+        stream_request,
+        destination_dir,
+        transfer_progress,
+        checksum_algorithm,
+        progress_callback=None,
+        archive_path=None,
+    ):
+        """Extract tar archive while it is downloaded.
+
+        Args:
+            stream_request (tuple[str, Union[dict[str, str], None], str]):
+                Output of 'get_stream_request'.
+            destination_dir (str): Directory where content is extracted.
+            transfer_progress (ayon_api.TransferProgress): Progress of
+                transferred content.
+            checksum_algorithm (Union[str, None]): Algorithm used for
+                checksum. Checksum is not calculated if is not set.
+            progress_callback (Optional[Callable[[int], None]]): Called
+                with size of each extracted file.
+            archive_path (Optional[str]): Store also the archive to the path.
+
+        Returns:
+            Union[str, None]: Checksum of received content if was calculated.
+        """
+
+        url, headers, filename = stream_request
+        archive_ext, archive_type = get_archive_ext_and_type(filename)
+        if archive_type != "tar":
+            raise ValueError(f"{filename} can't be extracted as stream")
+
+        cls.log.debug(f"Extracting {url} to {destination_dir}")
+        return RemoteFileHandler.stream_extract_tar(
+            url,
+            destination_dir,
+            archive_ext,
+            headers=headers,
+            checksum_algorithm=checksum_algorithm,
+            transfer_progress=transfer_progress,
+            progress_callback=progress_callback,
+            archive_path=archive_path,
+        )
+
+    @classmethod
+    def download_segmented(
+        cls,
+        url,
+        filepath,
+        headers,
+        transfer_progress,
+        checksum_algorithm=None,
+        content_size=None,
+    ):
+        """Try to download file using concurrent range requests.
+
+        Checksum is calculated in order while segments are downloaded.
+
+        Args:
+            url (str): Url to download.
+            filepath (str): Path where file is downloaded.
+            headers (Union[dict[str, str], None]): Request headers.
+            transfer_progress (ayon_api.TransferProgress): Progress of
+                transferred content.
+            checksum_algorithm (Optional[str]): Algorithm of checksum
+                calculated during download.
+            content_size (Optional[int]): Size of file if is known, range
+                request support is not probed for small files.
+
+        Returns:
+            tuple[bool, Union[str, None]]: File was downloaded and its
+                checksum. 'False' means that segmented download can't be
+                used and regular download should be used.
+
+        Raises:
+            Exception: Segmented download failed and received content
+                is kept, so next download continues from it.
+        """
+
+        segments = get_download_segments()
+        if segments < 2:
+            return False, None
+
+        if (
+            content_size is not None
+            and content_size < SEGMENTED_DOWNLOAD_MIN_SIZE
+        ):
+            return False, None
+
+        download = SegmentedFileDownload(
+            url,
+            filepath,
+            headers=headers,
+            segments=segments,
+            transfer_progress=transfer_progress,
+            checksum_algorithm=checksum_algorithm,
+        )
+        try:
+            downloaded = download.download()
+        except Exception:
+            # Regular download would start again from first byte
+            if download.has_partial_content:
+                raise
+            cls.log.warning(
+                f"Segmented download of {url} failed", exc_info=True
+            )
+            return False, None
+
+        if downloaded:
+            cls.log.debug(
+                f"Downloaded {url} using {segments} segments"
+            )
+        return downloaded, download.checksum
+
+    @classmethod
+    def check_hash(
+        cls,
+        filepath,
+        checksum,
+        checksum_algorithm="sha256",
+        calculated_checksum=None
+    ):
         """Compares 'hash' of downloaded 'addon_url' file.
 
+        File is read only if checksum was not calculated during download,
+            or if the calculated checksum does not match.
+
         Args:
             filepath (str): Local path to addon file.
             checksum (str): Hash of downloaded file.
             checksum_algorithm (str): Type of hash.
+            calculated_checksum (Optional[str]): Checksum calculated
+                during download.
 
         Raises:
             ValueError if hashes doesn't match
         """
 
+        if calculated_checksum is not None and calculated_checksum == checksum:
+            return
+
         if not validate_file_checksum(filepath, checksum, checksum_algorithm):
             raise ValueError(f"{filepath} doesn't match expected hash.")
 
     @classmethod
-    def unzip(cls, filepath, destination_dir):
+    def unzip(cls, filepath, destination_dir, progress_callback=None):
         """Unzips local 'addon_zip_path' to 'destination'.
 
         Args:
             filepath (str): local path to addon zip file
             destination_dir (str): local folder to unzip
+            progress_callback (Optional[Callable[[int], None]]): Called
+                with size of each extracted file.
         """
 
-        extract_archive_file(filepath, destination_dir)
+        extract_archive_file(
+            filepath, destination_dir, progress_callback=progress_callback
+        )
         os.remove(filepath)
 
 
 class OSDownloader(SourceDownloader):
     """Downloader using files from file drive."""
 
+    # Files are not downloaded, they're used directly from the drive
+    cacheable = False
+
     @classmethod
     def download(cls, source, destination_dir, data, transfer_progress):
         # OS doesn't need to download, unzip directly
@@ -109,6 +337,13 @@ class HTTPDownloader(SourceDownloader):
             filename = os.path.basename(source_url)
         return filename
 
+    @classmethod
+    def get_stream_request(cls, source, data):
+        source_url = source["url"]
+        if RemoteFileHandler._get_google_drive_file_id(source_url):
+            return None
+        return source_url, source.get("headers"), cls.get_filename(source)
+
     @classmethod
     def download(cls, source, destination_dir, data, transfer_progress):
         source_url = source["url"]
@@ -126,6 +361,43 @@ class HTTPDownloader(SourceDownloader):
 
         return os.path.join(destination_dir, filename)
 
+    @classmethod
+    def download_with_checksum(
+        cls,
+        source,
+        destination_dir,
+        data,
+        transfer_progress,
+        checksum_algorithm
+    ):
+        source_url = source["url"]
+        cls.log.debug(f"Downloading {source_url} to {destination_dir}")
+        headers = source.get("headers")
+        filename = cls.get_filename(source)
+
+        filepath = os.path.join(destination_dir, filename)
+        if RemoteFileHandler._get_google_drive_file_id(source_url) is None:
+            downloaded, checksum = cls.download_segmented(
+                source_url,
+                filepath,
+                headers,
+                transfer_progress,
+                checksum_algorithm,
+                data.get("size"),
+            )
+            if downloaded:
+                return filepath, checksum
+
+        checksum = RemoteFileHandler.download_url(
+            source_url,
+            destination_dir,
+            filename,
+            headers=headers,
+            checksum_algorithm=checksum_algorithm
+        )
+
+        return filepath, checksum
+
     @classmethod
     def cleanup(cls, source, destination_dir, data):
         filename = cls.get_filename(source)
@@ -134,6 +406,90 @@ class HTTPDownloader(SourceDownloader):
             os.remove(filepath)
 
 
+class _GrowingFileHasher:
+    """Calculate checksum of a file while it is written by other code.
+
+    File is read right after a chunk was written to it, so the content is
+    still in OS file cache and hashing does not cause another read pass
+    from the storage.
+
+    Args:
+        filepath (str): Path to a file that is being written.
+        checksum_algorithm (str): Algorithm used for checksum.
+    """
+
+    read_size = 128 * 1024
+
+    def __init__(self, filepath, checksum_algorithm):
+        self._filepath = filepath
+        self._hash_obj = get_checksum_object(checksum_algorithm)
+        self._buffer = memoryview(bytearray(self.read_size))
+        self._stream = None
+        self._position = 0
+
+    def update(self, max_position=None):
+        """Hash content which was written since last update.
+
+        Args:
+            max_position (Optional[int]): Do not read behind the position.
+        """
+
+        if self._stream is None:
+            if not os.path.exists(self._filepath):
+                return
+            self._stream = open(self._filepath, "rb", buffering=0)
+
+        while max_position is None or self._position < max_position:
+            buffer = self._buffer
+            if max_position is not None:
+                buffer = buffer[:max_position - self._position]
+            size = self._stream.readinto(buffer)
+            if not size:
+                break
+            self._hash_obj.update(buffer[:size])
+            self._position += size
+
+    def finish(self):
+        """Hash rest of the file and return checksum.
+
+        Returns:
+            str: Checksum of the file content.
+        """
+
+        try:
+            self.update()
+        finally:
+            if self._stream is not None:
+                self._stream.close()
+                self._stream = None
+        return self._hash_obj.hexdigest()
+
+
+class _HashingTransferProgress:
+    """Transfer progress wrapper feeding written chunks to hasher.
+
+    Downloads from AYON server are written to a file by 'ayon_api', the
+    progress object is the only hook called after each written chunk.
+
+    Args:
+        transfer_progress (ayon_api.TransferProgress): Wrapped progress.
+        hasher (_GrowingFileHasher): Hasher of downloaded file.
+    """
+
+    def __init__(self, transfer_progress, hasher):
+        self._transfer_progress = transfer_progress
+        self._hasher = hasher
+        self._transferred = 0
+
+    def __getattr__(self, attr_name):
+        return getattr(self._transfer_progress, attr_name)
+
+    def add_transferred_chunk(self, chunk_size):
+        self._transfer_progress.add_transferred_chunk(chunk_size)
+        self._transferred += chunk_size
+        self._hasher.update(self._transferred)
+
+
 class AyonServerDownloader(SourceDownloader):
     """Downloads static resource file from AYON Server.
 
@@ -142,12 +498,119 @@ class AyonServerDownloader(SourceDownloader):
 
     CHUNK_SIZE = 8192
 
-    @classmethod
-    def download(cls, source, destination_dir, data, transfer_progress):
+    @staticmethod
+    def get_filename(source):
         path = source["path"]
         filename = source["filename"]
         if path and not filename:
             filename = path.split("/")[-1]
+        return filename
+
+    @staticmethod
+    def get_headers():
+        """Headers with authorization of current connection.
+
+        Returns:
+            Union[dict[str, str], None]: Request headers.
+        """
+
+        try:
+            return ayon_api.get_server_api_connection().get_headers()
+        except Exception:
+            return None
+
+    @classmethod
+    def get_download_url(cls, source, data):
+        """Url of a file on AYON server.
+
+        Returns:
+            Union[str, None]: Url or None if can't be determined.
+        """
+
+        try:
+            base_url = ayon_api.get_base_url().rstrip("/")
+        except Exception:
+            return None
+
+        path = source["path"]
+        filename = cls.get_filename(source)
+        if path:
+            if path.startswith(base_url):
+                return path
+            return f"{base_url}/api/{path.strip('/')}"
+
+        if data["type"] == "dependency_package":
+            return f"{base_url}/api/dependency_packages/{data['name']}"
+
+        if data["type"] == "addon":
+            return (
+                f"{base_url}/addons/{data['name']}/{data['version']}"
+                f"/private/{filename}"
+            )
+
+        if data["type"] == "installer":
+            return f"{base_url}/api/desktop/installers/{filename}"
+        return None
+
+    @classmethod
+    def get_stream_request(cls, source, data):
+        url = cls.get_download_url(source, data)
+        if not url:
+            return None
+        return url, cls.get_headers(), cls.get_filename(source)
+
+    @classmethod
+    def download_with_checksum(
+        cls,
+        source,
+        destination_dir,
+        data,
+        transfer_progress,
+        checksum_algorithm
+    ):
+        if not checksum_algorithm:
+            return super().download_with_checksum(
+                source,
+                destination_dir,
+                data,
+                transfer_progress,
+                checksum_algorithm
+            )
+
+        filepath = os.path.join(destination_dir, cls.get_filename(source))
+        url = cls.get_download_url(source, data)
+        if url:
+            downloaded, checksum = cls.download_segmented(
+                url,
+                filepath,
+                cls.get_headers(),
+                transfer_progress,
+                checksum_algorithm,
+                data.get("size"),
+            )
+            if downloaded:
+                return filepath, checksum
+
+        hasher = _GrowingFileHasher(filepath, checksum_algorithm)
+        output = cls.download(
+            source,
+            destination_dir,
+            data,
+            _HashingTransferProgress(transfer_progress, hasher)
+        )
+        checksum = hasher.finish()
+        # Downloaded file is somewhere else than expected
+        if (
+            not isinstance(output, str)
+            or os.path.normpath(output) != os.path.normpath(filepath)
+        ):
+            checksum = None
+        return output, checksum
+
+    @classmethod
+    def download(cls, source, destination_dir, data, transfer_progress):
+        path = source["path"]
+        filename = cls.get_filename(source)
 
         cls.log.debug(f"Downloading {filename} to {destination_dir}")
 
@@ -200,6 +663,157 @@ class AyonServerDownloader(SourceDownloader):
             os.remove(filepath)
 
 
+class PeerDownloader(SourceDownloader):
+    """Downloads archives from artifacts cache of machines in local network.
+
+    Peers are asked in order defined by 'AYON_DISTRIBUTION_PEERS', first
+    peer which has archive with the checksum is used. Download fails if
+    none of peers has it, so next source of distribution item is used.
+    """
+
+    # Timeout for check if peer has the archive
+    LOOKUP_TIMEOUT = 2
+    # Seconds for which is result of lookup on peers reused
+    LOOKUP_CACHE_TTL = 60
+    _lookup_cache = {}
+    _lookup_lock = threading.Lock()
+
+    @staticmethod
+    def get_filename(source):
+        return source.get("filename")
+
+    @classmethod
+    def _find_artifact(cls, url):
+        """Check if peer has archive.
+
+        Args:
+            url (str): Url of archive on peer.
+
+        Returns:
+            Union[tuple[str, int], None]: Filename and size of archive.
+        """
+
+        request = urllib.request.Request(url, method="HEAD")
+        try:
+            with urllib.request.urlopen(
+                request, timeout=cls.LOOKUP_TIMEOUT
+            ) as response:
+                disposition = response.headers.get("Content-Disposition")
+                size = int(response.headers.get("Content-Length") or 0)
+        except Exception:
+            return None
+
+        match = re.search(r'filename="([^"/\\]+)"', disposition or "")
+        if match is None:
+            return None
+        return match.group(1), size
+
+    @classmethod
+    def _find_peer_artifact(cls, checksum, checksum_algorithm):
+        """Find first peer which has archive.
+
+        Result is cached, so stream request and download of the same item
+        don't wait for unavailable peers twice.
+
+        Args:
+            checksum (str): Checksum of archive.
+            checksum_algorithm (str): Algorithm of checksum.
+
+        Returns:
+            Union[tuple[str, str, int], None]: Url, filename and size
+                of archive.
+        """
+
+        peer_urls = tuple(get_distribution_peers())
+        key = (checksum, checksum_algorithm, peer_urls)
+        with cls._lookup_lock:
+            cached = cls._lookup_cache.get(key)
+        if cached is not None:
+            lookup_time, result = cached
+            if time.monotonic() - lookup_time < cls.LOOKUP_CACHE_TTL:
+                return result
+
+        result = None
+        for peer_url in peer_urls:
+            url = get_artifact_url(peer_url, checksum, checksum_algorithm)
+            artifact = cls._find_artifact(url)
+            if artifact is not None:
+                result = (url, *artifact)
+                break
+
+        with cls._lookup_lock:
+            cls._lookup_cache[key] = (time.monotonic(), result)
+        return result
+
+    @classmethod
+    def _forget_peer_artifact(cls, checksum, checksum_algorithm):
+        key = (
+            checksum, checksum_algorithm, tuple(get_distribution_peers())
+        )
+        with cls._lookup_lock:
+            cls._lookup_cache.pop(key, None)
+
+    @classmethod
+    def get_stream_request(cls, source, data):
+        artifact = cls._find_peer_artifact(
+            source["checksum"], source["checksum_algorithm"]
+        )
+        if artifact is None:
+            return None
+        url, filename, _ = artifact
+        return url, None, cls.get_filename(source) or filename
+
+    @classmethod
+    def download_with_checksum(
+        cls,
+        source,
+        destination_dir,
+        data,
+        transfer_progress,
+        checksum_algorithm
+    ):
+        checksum = source["checksum"]
+        algorithm = source["checksum_algorithm"]
+        artifact = cls._find_peer_artifact(checksum, algorithm)
+        if artifact is None:
+            raise ValueError(
+                f"None of peers has archive with checksum {checksum}"
+            )
+
+        url, filename, size = artifact
+        filepath = os.path.join(
+            destination_dir, cls.get_filename(source) or filename
+        )
+        cls.log.debug(f"Downloading {url} to {filepath}")
+        transfer_progress.set_content_size(size)
+        try:
+            calculated_checksum = RemoteFileHandler._urlretrieve(
+                url, filepath, checksum_algorithm=checksum_algorithm
+            )
+        except Exception:
+            # Peer may not be available anymore
+            cls._forget_peer_artifact(checksum, algorithm)
+            raise
+        transfer_progress.add_transferred_chunk(size)
+        return filepath, calculated_checksum
+
+    @classmethod
+    def download(cls, source, destination_dir, data, transfer_progress):
+        filepath, _ = cls.download_with_checksum(
+            source, destination_dir, data, transfer_progress, None
+        )
+        return filepath
+
+    @classmethod
+    def cleanup(cls, source, destination_dir, data):
+        filename = cls.get_filename(source)
+        if not filename:
+            return
+        filepath = os.path.join(destination_dir, filename)
+        if os.path.exists(filepath) and os.path.isfile(filepath):
+            os.remove(filepath)
+
+
 class DownloadFactory:
     """Factory for downloaders."""
 
@@ -241,4 +855,5 @@ def get_default_download_factory():
     download_factory.register_format(UrlType.FILESYSTEM, OSDownloader)
     download_factory.register_format(UrlType.HTTP, HTTPDownloader)
     download_factory.register_format(UrlType.SERVER, AyonServerDownloader)
+    download_factory.register_format(UrlType.PEER, PeerDownloader)
     return download_factory
@@ -0,0 +1,142 @@
+"""Events of distribution progress.
+
+Distribution items report start of their sources, phases, transferred
+bytes and completion as events. Listeners don't have to poll state of
+distribution items, they are notified when something changed.
+
+Callbacks are called in thread where the event happened, which is
+usually a distribution worker thread. Callbacks should be fast and must
+be thread safe.
+"""
+
+import time
+import logging
+import threading
+
+import attr
+import ayon_api
+
+# Progress events of single transfer are not emitted more often
+PROGRESS_EVENT_INTERVAL = 0.1
+
+
+class DistributionEventTopic:
+    DISTRIBUTION_STARTED = "distribution.started"
+    DISTRIBUTION_FINISHED = "distribution.finished"
+    ITEM_STARTED = "item.started"
+    ITEM_FINISHED = "item.finished"
+    SOURCE_STARTED = "source.started"
+    SOURCE_FAILED = "source.failed"
+    PHASE_STARTED = "phase.started"
+    PHASE_FINISHED = "phase.finished"
+    TRANSFER_PROGRESS = "transfer.progress"
+    UNZIP_PROGRESS = "unzip.progress"
+
+
+@attr.s
+class DistributionEvent(object):
+    topic = attr.ib()
+    item_label = attr.ib(default=None)
+    data = attr.ib(default=attr.Factory(dict))
+    timestamp = attr.ib(default=attr.Factory(time.time))
+
+
+class DistributionEventHub:
+    """Dispatch distribution events to registered callbacks.
+
+    Args:
+        logger (Optional[logging.Logger]): Logger object.
+    """
+
+    def __init__(self, logger=None):
+        if logger is None:
+            logger = logging.getLogger(self.__class__.__name__)
+        self.log = logger
+        self._lock = threading.Lock()
+        self._callbacks = []
+
+    def add_callback(self, callback):
+        """Register callback called with each event.
+
+        Args:
+            callback (Callable[[DistributionEvent], None]): Callback.
+        """
+
+        with self._lock:
+            self._callbacks.append(callback)
+
+    def remove_callback(self, callback):
+        with self._lock:
+            if callback in self._callbacks:
+                self._callbacks.remove(callback)
+
+    def emit(self, topic, item_label=None, **data):
+        """Create event and pass it to callbacks.
+
+        Failing callback does not affect distribution or other callbacks.
+
+        Args:
+            topic (str): Event topic from 'DistributionEventTopic'.
+            item_label (Optional[str]): Label of distribution item.
+            **data (Any): Event data.
+        """
+
+        with self._lock:
+            callbacks = list(self._callbacks)
+        if not callbacks:
+            return
+
+        event = DistributionEvent(topic, item_label, data)
+        for callback in callbacks:
+            try:
+                callback(event)
+            except Exception:
+                self.log.warning(
+                    f"Distribution event callback failed on '{topic}'",
+                    exc_info=True
+                )
+
+
+class ReportingTransferProgress(ayon_api.TransferProgress):
+    """Transfer progress which reports changes of transferred size.
+
+    Progress is reported at most once per 'PROGRESS_EVENT_INTERVAL', so
+    callbacks are not called for each downloaded chunk.
+    """
+
+    def __init__(self, *args, **kwargs):
+        super().__init__(*args, **kwargs)
+        self._report_callback = None
+        self._last_report = 0.0
+
+    def set_report_callback(self, callback):
+        """Set callback called when transferred size changed.
+
+        Args:
+            callback (Union[Callable[[int, Union[int, None]], None], None]):
+                Called with transferred size and content size.
+        """
+
+        self._report_callback = callback
+
+    def add_transferred_chunk(self, chunk_size):
+        super().add_transferred_chunk(chunk_size)
+        self._report()
+
+    def set_transferred_size(self, transferred_size):
+        super().set_transferred_size(transferred_size)
+        self._report()
+
+    def set_transfer_done(self):
+        super().set_transfer_done()
+        self._report(force=True)
+
+    def _report(self, force=False):
+        callback = self._report_callback
+        if callback is None:
+            return
+        now = time.monotonic()
+        if not force and now - self._last_report < PROGRESS_EVENT_INTERVAL:
+            return
+        self._last_report = now
+        callback(self.get_transferred_size(), self.get_content_size())
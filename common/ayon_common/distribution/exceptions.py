@@ -14,3 +14,19 @@ class BundleNotFoundError(Exception):
 
 class InstallerDistributionError(Exception):
     pass
+
+
+class DistributionLockTimeoutError(Exception):
+    """Other process did not finish distribution of an item in time.
+
+    Args:
+        filepath (str): Path to lock file.
+        timeout (float): Waited time in seconds.
+    """
+
+    def __init__(self, filepath, timeout):
+        self.filepath = filepath
+        self.timeout = timeout
+        super().__init__(
+            f"Lock '{filepath}' was not released in {timeout:.0f}s"
+        )
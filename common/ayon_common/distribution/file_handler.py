@@ -1,29 +1,336 @@
 import os
 import re
+import json
+import time
+import socket
 import urllib
 from urllib.parse import urlparse
 import urllib.request
 import urllib.error
+import http.client
 import itertools
+import threading
+from concurrent.futures import ThreadPoolExecutor
 
 import requests
 
+from ayon_common.utils import (
+    get_checksum_object,
+    open_tar_archive,
+    extract_tar_file,
+)
+from ayon_common.checksum import update_checksum_from_stream
+
 USER_AGENT = "AYON-launcher"
+PART_FILE_EXT = ".part"
+# Partial file of segmented download, positions of segments are stored
+#   in json file next to it
+SEGMENTS_PART_FILE_EXT = ".segments.part"
+# Smaller files are downloaded using single request
+SEGMENTED_DOWNLOAD_MIN_SIZE = 64 * 1024 * 1024
+# Errors after which is download resumed
+RETRY_EXCEPTIONS = (
+    http.client.HTTPException,
+    urllib.error.URLError,
+    ConnectionError,
+    socket.timeout,
+)
+
+
+def _get_response_validator(headers):
+    """Value for 'If-Range' header from response headers.
+
+    Args:
+        headers (http.client.HTTPMessage): Response headers.
+
+    Returns:
+        Union[str, None]: 'ETag' or 'Last-Modified' value.
+    """
+
+    etag = headers.get("ETag")
+    # Weak ETag can't be used for range requests
+    if etag and etag.startswith("W/"):
+        etag = None
+    return etag or headers.get("Last-Modified")
+
+
+def _get_content_range_start(response):
+    """First byte of content in partial response.
+
+    Args:
+        response (http.client.HTTPResponse): Response with 206 status.
+
+    Returns:
+        Union[int, None]: First byte position or None if is not available.
+    """
+
+    content_range = response.headers.get("Content-Range") or ""
+    match = re.match(r"bytes\s+(\d+)-", content_range)
+    if match is None:
+        return None
+    return int(match.group(1))
+
+
+class _PartialDownloadState:
+    """Partial file of download with metadata needed to resume it.
+
+    Metadata with 'ETag' and 'Last-Modified' of downloaded content are
+    stored next to the partial file, so download can be resumed also by
+    another process.
+
+    Args:
+        part_path (str): Path to partial file.
+        checksum_algorithm (Union[str, None]): Calculate checksum of
+            downloaded content using the algorithm.
+    """
+
+    def __init__(self, part_path, checksum_algorithm=None):
+        self._part_path = part_path
+        self._metadata_path = f"{part_path}.json"
+        self._checksum_algorithm = checksum_algorithm
+        self._hash_obj = None
+        self._hashed_size = 0
+
+    def get_part_size(self):
+        if os.path.exists(self._part_path):
+            return os.path.getsize(self._part_path)
+        return 0
+
+    def get_validator(self, url):
+        """Value for 'If-Range' header if partial file can be resumed.
+
+        Args:
+            url (str): Url which is downloaded.
+
+        Returns:
+            Union[str, None]: 'ETag' or 'Last-Modified' value.
+        """
+
+        if not os.path.exists(self._metadata_path):
+            return None
+        try:
+            with open(self._metadata_path, "r") as stream:
+                metadata = json.load(stream)
+        except ValueError:
+            return None
+
+        if metadata.get("url") != url.replace("https:", "http:", 1):
+            return None
+        return metadata.get("etag") or metadata.get("last_modified")
+
+    def store_metadata(self, url, headers):
+        etag = headers.get("ETag")
+        # Weak ETag can't be used for range requests
+        if etag and etag.startswith("W/"):
+            etag = None
+        with open(self._metadata_path, "w") as stream:
+            json.dump(
+                {
+                    # Same content is expected on http and https
+                    "url": url.replace("https:", "http:", 1),
+                    "etag": etag,
+                    "last_modified": headers.get("Last-Modified"),
+                },
+                stream
+            )
+
+    def remove_metadata(self):
+        if os.path.exists(self._metadata_path):
+            os.remove(self._metadata_path)
+
+    def reset(self):
+        """Throw away downloaded content."""
+
+        if os.path.exists(self._part_path):
+            os.remove(self._part_path)
+        self.remove_metadata()
+        self._hash_obj = None
+        self._hashed_size = 0
+
+    def open_part(self):
+        """Open partial file for append.
+
+        Checksum of already downloaded content is calculated if is not
+        known yet (e.g. partial file from previous process).
+
+        Returns:
+            io.BufferedWriter: Opened partial file.
+        """
+
+        if self._checksum_algorithm:
+            part_size = self.get_part_size()
+            if self._hash_obj is None or self._hashed_size != part_size:
+                self._hash_part()
+        return open(self._part_path, "ab")
+
+    def update(self, chunk):
+        if self._hash_obj is not None:
+            self._hash_obj.update(chunk)
+            self._hashed_size += len(chunk)
+
+    def get_checksum(self):
+        if not self._checksum_algorithm:
+            return None
+        if self._hash_obj is None:
+            self._hash_part()
+        return self._hash_obj.hexdigest()
+
+    def _hash_part(self):
+        hash_obj = get_checksum_object(self._checksum_algorithm)
+        hashed_size = 0
+        if os.path.exists(self._part_path):
+            with open(self._part_path, "rb", buffering=0) as stream:
+                hashed_size = update_checksum_from_stream(hash_obj, stream)
+        self._hash_obj = hash_obj
+        self._hashed_size = hashed_size
+
+
+class _ResumableResponseStream:
+    """Readable stream of url content which reconnects when it fails.
+
+    Lost connection is resumed with range request from the last received
+    byte, so code reading the stream (e.g. 'tarfile') does not notice it.
+    Received content is hashed, written to optional file and reported to
+    transfer progress.
+
+    Args:
+        url (str): Url to download.
+        headers (dict[str, str]): Request headers.
+        transfer_progress (Optional[ayon_api.TransferProgress]): Progress
+            of received content.
+        hash_obj (Optional[Any]): Hash object updated with content.
+        tee_stream (Optional[BinaryIO]): Stream where content is written.
+    """
+
+    def __init__(
+        self,
+        url,
+        headers,
+        transfer_progress=None,
+        hash_obj=None,
+        tee_stream=None,
+    ):
+        self._url = url
+        self._headers = headers
+        self._transfer_progress = transfer_progress
+        self._hash_obj = hash_obj
+        self._tee_stream = tee_stream
+        self._response = None
+        self._validator = None
+        self._content_length = None
+        self._position = 0
+        self._attempt = 0
+
+    def _open(self):
+        headers = dict(self._headers)
+        if self._position:
+            if not self._validator:
+                raise ValueError(
+                    f"Server does not allow to resume download of {self._url}"
+                )
+            headers["Range"] = f"bytes={self._position}-"
+            headers["If-Range"] = self._validator
+
+        response = urllib.request.urlopen(
+            urllib.request.Request(self._url, headers=headers),
+            timeout=RemoteFileHandler.timeout
+        )
+        if not self._position:
+            self._validator = (
+                response.headers.get("ETag")
+                or response.headers.get("Last-Modified")
+            )
+            content_length = response.headers.get("Content-Length")
+            if content_length:
+                self._content_length = int(content_length)
+                if self._transfer_progress is not None:
+                    self._transfer_progress.set_content_size(
+                        self._content_length
+                    )
+
+        elif (
+            response.status != 206
+            or _get_content_range_start(response) != self._position
+        ):
+            response.close()
+            raise ValueError(f"Server did not resume download of {self._url}")
+        self._response = response
+
+    def _close_response(self):
+        if self._response is not None:
+            self._response.close()
+            self._response = None
+
+    def read(self, size=-1):
+        while True:
+            try:
+                if self._response is None:
+                    self._open()
+                data = self._response.read(size)
+                if (
+                    not data
+                    and self._content_length is not None
+                    and self._position < self._content_length
+                ):
+                    raise http.client.IncompleteRead(
+                        b"", self._content_length - self._position
+                    )
+                break
+
+            except RETRY_EXCEPTIONS as exc:
+                if isinstance(exc, urllib.error.HTTPError):
+                    raise
+                self._close_response()
+                self._attempt += 1
+                if self._attempt > RemoteFileHandler.max_retries:
+                    raise
+                print((
+                    f"Download of {self._url} interrupted ({exc})."
+                    f" Resuming from byte {self._position}"
+                    f" (attempt {self._attempt}"
+                    f"/{RemoteFileHandler.max_retries})."
+                ))
+                time.sleep(RemoteFileHandler.retry_delay * self._attempt)
+
+        if data:
+            self._position += len(data)
+            if self._hash_obj is not None:
+                self._hash_obj.update(data)
+            if self._tee_stream is not None:
+                self._tee_stream.write(data)
+            if self._transfer_progress is not None:
+                self._transfer_progress.add_transferred_chunk(len(data))
+        return data
+
+    def close(self):
+        self._close_response()
 
 
 class RemoteFileHandler:
     """Download file from url, might be GDrive shareable link"""
 
+    # How many times is interrupted download resumed
+    max_retries = 5
+    # Base delay in seconds between retries, multiplied by attempt
+    retry_delay = 1.0
+    # Seconds without received data after which is connection stalled
+    timeout = 60
+
     @staticmethod
     def download_url(
         url,
         root,
         filename=None,
         max_redirect_hops=3,
-        headers=None
+        headers=None,
+        checksum_algorithm=None,
     ):
         """Download a file from url and place it in root.
 
+        Checksum of downloaded content is calculated from received chunks
+        when 'checksum_algorithm' is passed, so it is not needed to read
+        the file again to validate it.
+
         Args:
             url (str): URL to download file from
             root (str): Directory to place downloaded file in
@@ -33,6 +340,12 @@ class RemoteFileHandler:
                 hops allowed
             headers (Optional[dict[str, str]]): Additional required headers
                 - Authentication etc..
+            checksum_algorithm (Optional[str]): Calculate checksum of
+                downloaded content using the algorithm.
+
+        Returns:
+            Union[str, None]: Checksum of downloaded file if
+                'checksum_algorithm' was passed.
         """
 
         root = os.path.expanduser(root)
@@ -50,12 +363,17 @@ class RemoteFileHandler:
         file_id = RemoteFileHandler._get_google_drive_file_id(url)
         if file_id is not None:
             return RemoteFileHandler.download_file_from_google_drive(
-                file_id, root, filename)
+                file_id, root, filename, checksum_algorithm)
 
         # download the file
         try:
             print(f"Downloading {url} to {fpath}")
-            RemoteFileHandler._urlretrieve(url, fpath, headers=headers)
+            return RemoteFileHandler._urlretrieve(
+                url,
+                fpath,
+                headers=headers,
+                checksum_algorithm=checksum_algorithm
+            )
         except (urllib.error.URLError, IOError) as exc:
             if url[:5] != "https":
                 raise exc
@@ -65,16 +383,29 @@ class RemoteFileHandler:
                 "Failed download. Trying https -> http instead."
                 f" Downloading {url} to {fpath}"
             ))
-            RemoteFileHandler._urlretrieve(url, fpath, headers=headers)
+            return RemoteFileHandler._urlretrieve(
+                url,
+                fpath,
+                headers=headers,
+                checksum_algorithm=checksum_algorithm
+            )
 
     @staticmethod
-    def download_file_from_google_drive(file_id, root, filename=None):
+    def download_file_from_google_drive(
+        file_id, root, filename=None, checksum_algorithm=None
+    ):
         """Download a Google Drive file from  and place it in root.
         Args:
             file_id (str): id of file to be downloaded
             root (str): Directory to place downloaded file in
             filename (str, optional): Name to save the file under.
                 If None, use the id of the file.
+            checksum_algorithm (Optional[str]): Calculate checksum of
+                downloaded content using the algorithm.
+
+        Returns:
+            Union[str, None]: Checksum of downloaded file if
+                'checksum_algorithm' was passed.
         """
         # Based on https://stackoverflow.com/questions/38511444/python-download-files-from-google-drive-using-url # noqa
 
@@ -115,26 +446,210 @@ class RemoteFileHandler:
             )
             raise RuntimeError(msg)
 
+        hash_obj = None
+        if checksum_algorithm:
+            hash_obj = get_checksum_object(checksum_algorithm)
         RemoteFileHandler._save_response_content(
             itertools.chain((first_chunk, ),
-                            response_content_generator), fpath)
+                            response_content_generator), fpath, hash_obj)
         response.close()
+        if hash_obj is not None:
+            return hash_obj.hexdigest()
+        return None
 
     @staticmethod
-    def _urlretrieve(url, filename, chunk_size=None, headers=None):
+    def stream_extract_tar(
+        url,
+        dst_folder,
+        archive_ext,
+        headers=None,
+        checksum_algorithm=None,
+        transfer_progress=None,
+        progress_callback=None,
+        archive_path=None,
+        chunk_size=None,
+    ):
+        """Extract tar archive from url while it is downloaded.
+
+        Archive is not stored to disk unless 'archive_path' is passed,
+            checksum is calculated from received content. Content of
+            'dst_folder' can't be trusted until the checksum is validated.
+
+        Args:
+            url (str): Url of tar archive.
+            dst_folder (str): Directory where content is extracted.
+            archive_ext (str): Archive extension from
+                'get_archive_ext_and_type'.
+            headers (Optional[dict[str, str]]): Additional headers.
+            checksum_algorithm (Optional[str]): Calculate checksum of
+                downloaded content using the algorithm.
+            transfer_progress (Optional[ayon_api.TransferProgress]): Progress
+                of received content.
+            progress_callback (Optional[Callable[[int], None]]): Called with
+                size of each extracted member.
+            archive_path (Optional[str]): Store also the archive to the path.
+            chunk_size (Optional[int]): Size of chunk read from response.
+
+        Returns:
+            Union[str, None]: Checksum of downloaded archive if
+                'checksum_algorithm' was passed.
+        """
+
+        final_headers = {"User-Agent": USER_AGENT}
+        if headers:
+            final_headers.update(headers)
+
+        chunk_size = chunk_size or 1024 * 1024
+        hash_obj = None
+        if checksum_algorithm:
+            hash_obj = get_checksum_object(checksum_algorithm)
+
+        tee_stream = None
+        if archive_path:
+            tee_stream = open(archive_path, "wb")
+
+        stream = _ResumableResponseStream(
+            url,
+            final_headers,
+            transfer_progress=transfer_progress,
+            hash_obj=hash_obj,
+            tee_stream=tee_stream,
+        )
+        try:
+            with open_tar_archive(
+                archive_ext, fileobj=stream, bufsize=chunk_size
+            ) as tar_file:
+                extract_tar_file(tar_file, dst_folder, progress_callback)
+
+            # Read rest of content after end of archive (padding),
+            #   it is part of checksum
+            while stream.read(chunk_size):
+                pass
+        finally:
+            stream.close()
+            if tee_stream is not None:
+                tee_stream.close()
+
+        if hash_obj is not None:
+            return hash_obj.hexdigest()
+        return None
+
+    @staticmethod
+    def _urlretrieve(
+        url, filename, chunk_size=None, headers=None, checksum_algorithm=None
+    ):
+        """Download url to a file with resume support.
+
+        Content is downloaded to '<filename>.part' file which is renamed
+            to 'filename' when download finishes. Partial file is kept
+            when download fails, and next attempt continues from its end
+            using 'Range' request. Resume is used only if server sent
+            'ETag' or 'Last-Modified' header which is used in 'If-Range'
+            header, so changed content on server is downloaded again
+            from start.
+
+        Args:
+            url (str): Url to download.
+            filename (str): Path where file is downloaded.
+            chunk_size (Optional[int]): Size of chunk read from response.
+            headers (Optional[dict[str, str]]): Additional headers.
+            checksum_algorithm (Optional[str]): Calculate checksum of
+                downloaded content using the algorithm.
+
+        Returns:
+            Union[str, None]: Checksum of downloaded file if
+                'checksum_algorithm' was passed.
+        """
+
         final_headers = {"User-Agent": USER_AGENT}
         if headers:
             final_headers.update(headers)
 
         chunk_size = chunk_size or 8192
-        with open(filename, "wb") as fh:
-            with urllib.request.urlopen(
-                urllib.request.Request(url, headers=final_headers)
-            ) as response:
-                for chunk in iter(lambda: response.read(chunk_size), ""):
-                    if not chunk:
-                        break
-                    fh.write(chunk)
+        part_path = f"{filename}{PART_FILE_EXT}"
+        state = _PartialDownloadState(part_path, checksum_algorithm)
+        attempt = 0
+        while True:
+            try:
+                RemoteFileHandler._download_part(
+                    url, state, final_headers, chunk_size
+                )
+                break
+
+            except RETRY_EXCEPTIONS as exc:
+                if isinstance(exc, urllib.error.HTTPError):
+                    raise
+                attempt += 1
+                if attempt > RemoteFileHandler.max_retries:
+                    raise
+                print((
+                    f"Download of {url} interrupted ({exc})."
+                    f" Resuming from byte {state.get_part_size()}"
+                    f" (attempt {attempt}/{RemoteFileHandler.max_retries})."
+                ))
+                time.sleep(RemoteFileHandler.retry_delay * attempt)
+
+        os.replace(part_path, filename)
+        state.remove_metadata()
+        return state.get_checksum()
+
+    @staticmethod
+    def _download_part(url, state, headers, chunk_size):
+        """Download content of url to partial file.
+
+        Args:
+            url (str): Url to download.
+            state (_PartialDownloadState): State of partial download.
+            headers (dict[str, str]): Request headers.
+            chunk_size (int): Size of chunk read from response.
+        """
+
+        request_headers = dict(headers)
+        part_size = state.get_part_size()
+        validator = state.get_validator(url)
+        if part_size and validator:
+            request_headers["Range"] = f"bytes={part_size}-"
+            request_headers["If-Range"] = validator
+
+        try:
+            response = urllib.request.urlopen(
+                urllib.request.Request(url, headers=request_headers),
+                timeout=RemoteFileHandler.timeout
+            )
+        except urllib.error.HTTPError as exc:
+            # Partial file is probably bigger than content on server
+            if exc.code != 416 or "Range" not in request_headers:
+                raise
+            state.reset()
+            response = urllib.request.urlopen(
+                urllib.request.Request(url, headers=headers),
+                timeout=RemoteFileHandler.timeout
+            )
+
+        with response:
+            resume = (
+                "Range" in request_headers
+                and response.status == 206
+                and _get_content_range_start(response) == part_size
+            )
+            if not resume:
+                state.reset()
+                state.store_metadata(url, response.headers)
+
+            content_length = response.headers.get("Content-Length")
+            received = 0
+            with state.open_part() as stream:
+                for chunk in iter(lambda: response.read(chunk_size), b""):
+                    stream.write(chunk)
+                    state.update(chunk)
+                    received += len(chunk)
+
+        # 'http.client' does not raise error if connection was closed
+        #   before whole content was received
+        if content_length and received < int(content_length):
+            raise http.client.IncompleteRead(
+                b"", int(content_length) - received
+            )
 
     @staticmethod
     def _get_redirect_url(url, max_hops, headers=None):
@@ -171,12 +686,14 @@ class RemoteFileHandler:
 
     @staticmethod
     def _save_response_content(
-        response_gen, destination,
+        response_gen, destination, hash_obj=None
     ):
         with open(destination, "wb") as f:
             for chunk in response_gen:
                 if chunk:  # filter out keep-alive new chunks
                     f.write(chunk)
+                    if hash_obj is not None:
+                        hash_obj.update(chunk)
 
     @staticmethod
     def _quota_exceeded(first_chunk):
@@ -197,3 +714,571 @@ class RemoteFileHandler:
             return None
 
         return match.group("id")
+
+
+class SegmentedFileDownload:
+    """Download file using multiple concurrent range requests.
+
+    File is split into byte ranges which are downloaded in parallel and
+    written with positional writes into preallocated file. Each segment
+    is retried separately and continues from the last received byte.
+
+    Download is not used when server does not support range requests or
+    when file is smaller than 'min_size', in that case 'download' returns
+    'False' and regular download should be used.
+
+    When checksum algorithm is passed, the file is hashed in order while
+    segments are downloaded. Content is read right behind the received
+    part of the first unfinished segment, so it is still in OS file cache.
+
+    Segments are downloaded to '<filepath>.segments.part' file. Received
+    position of each segment is stored next to it, so failed download
+    continues where segments ended. Received content is kept only if
+    server sent 'ETag' or 'Last-Modified' header, which is used in
+    'If-Range' header. Segmented download is not used if partial file
+    of regular download exists, so its download is resumed instead.
+
+    Args:
+        url (str): Url to download.
+        filepath (str): Path where file is downloaded.
+        headers (Optional[dict[str, str]]): Additional headers.
+        segments (Optional[int]): Number of concurrent segments.
+        transfer_progress (Optional[ayon_api.TransferProgress]): Progress
+            of download.
+        min_size (Optional[int]): Minimum size of file to use
+            segmented download.
+        checksum_algorithm (Optional[str]): Algorithm of checksum
+            calculated during download.
+    """
+
+    chunk_size = 1024 * 1024
+    # How many times is each segment retried
+    max_retries = 5
+    retry_delay = 1.0
+    timeout = 60
+    # Minimum seconds between stores of segment positions
+    state_store_interval = 1.0
+
+    def __init__(
+        self,
+        url,
+        filepath,
+        headers=None,
+        segments=4,
+        transfer_progress=None,
+        min_size=SEGMENTED_DOWNLOAD_MIN_SIZE,
+        checksum_algorithm=None,
+    ):
+        final_headers = {"User-Agent": USER_AGENT}
+        if headers:
+            final_headers.update(headers)
+        self._url = url
+        self._filepath = filepath
+        self._headers = final_headers
+        self._segments = max(1, segments)
+        self._transfer_progress = transfer_progress
+        self._min_size = min_size
+        self._checksum_algorithm = checksum_algorithm
+        self._checksum = None
+        self._progress_lock = threading.Lock()
+        self._progress_changed = threading.Condition(self._progress_lock)
+        self._ranges = []
+        self._positions = []
+        self._part_path = f"{filepath}{SEGMENTS_PART_FILE_EXT}"
+        self._state_path = f"{self._part_path}.json"
+        self._validator = None
+        self._state_stored = 0.0
+
+    @property
+    def checksum(self):
+        """Checksum of downloaded file.
+
+        Returns:
+            Union[str, None]: Checksum or None if checksum algorithm was
+                not passed or file was not downloaded.
+        """
+
+        return self._checksum
+
+    @property
+    def has_partial_content(self):
+        """Received content is kept to continue download later.
+
+        Returns:
+            bool: Partial file with positions of segments exists.
+        """
+
+        return os.path.exists(self._state_path)
+
+    def get_content_size(self):
+        """Size of content if server supports range requests.
+
+        Returns:
+            Union[int, None]: Size of content or None if range requests
+                are not supported.
+        """
+
+        return self._get_content_info()[0]
+
+    def _get_content_info(self):
+        headers = dict(self._headers)
+        headers["Range"] = "bytes=0-0"
+        with urllib.request.urlopen(
+            urllib.request.Request(self._url, headers=headers),
+            timeout=self.timeout
+        ) as response:
+            if response.status != 206:
+                return None, None
+            content_range = response.headers.get("Content-Range") or ""
+            match = re.match(r"bytes\s+0-0/(\d+)", content_range)
+            if match is None:
+                return None, None
+            return (
+                int(match.group(1)),
+                _get_response_validator(response.headers)
+            )
+
+    def _load_state(self, size):
+        """Load positions of segments from previous download.
+
+        Args:
+            size (int): Size of content on server.
+
+        Returns:
+            bool: Previous download can be continued.
+        """
+
+        if not self._validator or not os.path.exists(self._part_path):
+            return False
+        try:
+            with open(self._state_path, "r") as stream:
+                state = json.load(stream)
+            ranges = [tuple(item) for item in state["ranges"]]
+            positions = list(state["positions"])
+        except (OSError, ValueError, KeyError, TypeError):
+            return False
+
+        if (
+            state.get("url") != self._url.replace("https:", "http:", 1)
+            or state.get("validator") != self._validator
+            or state.get("size") != size
+            or os.path.getsize(self._part_path) != size
+            or len(ranges) != len(positions)
+        ):
+            return False
+        self._ranges = ranges
+        self._positions = positions
+        return True
+
+    def _store_state(self):
+        """Store positions of segments.
+
+        Must be called with progress lock.
+        """
+
+        self._state_stored = time.monotonic()
+        with open(self._state_path, "w") as stream:
+            json.dump(
+                {
+                    # Same content is expected on http and https
+                    "url": self._url.replace("https:", "http:", 1),
+                    "validator": self._validator,
+                    "size": self._ranges[-1][1] + 1,
+                    "ranges": self._ranges,
+                    "positions": self._positions,
+                },
+                stream
+            )
+
+    def _remove_partial_content(self):
+        for path in (self._state_path, self._part_path):
+            if os.path.exists(path):
+                os.remove(path)
+
+    def download(self):
+        """Download the file.
+
+        Returns:
+            bool: File was downloaded. 'False' if segmented download can't
+                be used.
+        """
+
+        if self._segments < 2:
+            return False
+
+        # Interrupted regular download is resumed from its partial file
+        if os.path.exists(f"{self._filepath}{PART_FILE_EXT}"):
+            return False
+
+        try:
+            size, validator = self._get_content_info()
+        except Exception:
+            return False
+
+        if size is None or size < self._min_size:
+            return False
+
+        dirpath = os.path.dirname(self._filepath)
+        if dirpath:
+            os.makedirs(dirpath, exist_ok=True)
+
+        self._validator = validator
+        part_path = self._part_path
+        if not self._load_state(size):
+            self._remove_partial_content()
+            # Preallocate file so segments can be written at their
+            #   positions
+            with open(part_path, "wb") as stream:
+                stream.truncate(size)
+
+            segment_size = -(-size // self._segments)
+            self._ranges = [
+                (start, min(start + segment_size, size) - 1)
+                for start in range(0, size, segment_size)
+            ]
+            self._positions = [start for start, _ in self._ranges]
+
+        ranges = self._ranges
+        if self._transfer_progress is not None:
+            self._transfer_progress.set_content_size(size)
+            received = sum(
+                position - start
+                for position, (start, _) in zip(self._positions, ranges)
+            )
+            if received:
+                self._transfer_progress.add_transferred_chunk(received)
+
+        if validator:
+            with self._progress_lock:
+                self._store_state()
+
+        try:
+            with ThreadPoolExecutor(
+                max_workers=len(ranges),
+                thread_name_prefix="ayon_segment"
+            ) as executor:
+                futures = [
+                    executor.submit(
+                        self._download_segment,
+                        part_path,
+                        idx,
+                        self._positions[idx],
+                        end
+                    )
+                    for idx, (_, end) in enumerate(ranges)
+                    if self._positions[idx] <= end
+                ]
+                checksum = None
+                if self._checksum_algorithm:
+                    checksum = self._hash_received(part_path, size, futures)
+                for future in futures:
+                    future.result()
+
+        except BaseException:
+            # Keep received content if download can be continued
+            if validator:
+                with self._progress_lock:
+                    self._store_state()
+            else:
+                self._remove_partial_content()
+            raise
+
+        os.replace(part_path, self._filepath)
+        if os.path.exists(self._state_path):
+            os.remove(self._state_path)
+        self._checksum = checksum
+        return True
+
+    def _get_received_size(self):
+        """Size of content received from the start of file.
+
+        Must be called with progress lock.
+
+        Returns:
+            int: Position where the first unfinished segment continues.
+        """
+
+        for position, (_, end) in zip(self._positions, self._ranges):
+            if position <= end:
+                return position
+        return self._ranges[-1][1] + 1 if self._ranges else 0
+
+    def _hash_received(self, part_path, size, futures):
+        """Hash file in order while segments are downloaded.
+
+        Args:
+            part_path (str): Path to downloaded file.
+            size (int): Size of the file.
+            futures (list[Future]): Futures of segment downloads.
+
+        Returns:
+            Union[str, None]: Checksum or None if any segment failed.
+        """
+
+        hash_obj = get_checksum_object(self._checksum_algorithm)
+        buffer = memoryview(bytearray(self.chunk_size))
+        hashed_size = 0
+        with open(part_path, "rb", buffering=0) as stream:
+            while hashed_size < size:
+                with self._progress_changed:
+                    while True:
+                        received_size = self._get_received_size()
+                        if received_size > hashed_size:
+                            break
+                        if any(
+                            future.done() and future.exception()
+                            for future in futures
+                        ):
+                            return None
+                        self._progress_changed.wait(0.5)
+
+                while hashed_size < received_size:
+                    read_size = stream.readinto(
+                        buffer[:received_size - hashed_size]
+                    )
+                    if not read_size:
+                        return None
+                    hash_obj.update(buffer[:read_size])
+                    hashed_size += read_size
+        return hash_obj.hexdigest()
+
+    def _add_transferred(self, idx, position, size):
+        with self._progress_changed:
+            self._positions[idx] = position
+            self._progress_changed.notify_all()
+            if self._transfer_progress is not None:
+                self._transfer_progress.add_transferred_chunk(size)
+            if (
+                self._validator
+                and time.monotonic() - self._state_stored
+                >= self.state_store_interval
+            ):
+                self._store_state()
+
+    def _download_segment(self, part_path, idx, start, end):
+        # Use list so received position is kept when request fails
+        position = [start]
+        attempt = 0
+        fd = os.open(part_path, os.O_WRONLY | getattr(os, "O_BINARY", 0))
+        try:
+            while position[0] <= end:
+                try:
+                    self._download_range(fd, idx, position, end)
+                except urllib.error.HTTPError:
+                    # Server refused the request, retry won't help
+                    raise
+                except RETRY_EXCEPTIONS:
+                    attempt += 1
+                    if attempt > self.max_retries:
+                        raise
+                    time.sleep(self.retry_delay * attempt)
+        finally:
+            os.close(fd)
+
+    def _download_range(self, fd, idx, position, end):
+        headers = dict(self._headers)
+        headers["Range"] = f"bytes={position[0]}-{end}"
+        if self._validator:
+            # Content changed on server if whole content is returned
+            headers["If-Range"] = self._validator
+        with urllib.request.urlopen(
+            urllib.request.Request(self._url, headers=headers),
+            timeout=self.timeout
+        ) as response:
+            if (
+                response.status != 206
+                or _get_content_range_start(response) != position[0]
+            ):
+                raise http.client.HTTPException(
+                    "Server did not return requested range"
+                    f" {position[0]}-{end}"
+                )
+
+            for chunk in iter(
+                lambda: response.read(self.chunk_size), b""
+            ):
+                chunk = chunk[:end + 1 - position[0]]
+                _write_at(fd, chunk, position[0])
+                position[0] += len(chunk)
+                self._add_transferred(idx, position[0], len(chunk))
+                if position[0] > end:
+                    break
+
+        if position[0] <= end:
+            raise http.client.IncompleteRead(b"", end + 1 - position[0])
+
+
+class HTTPRangeReader:
+    """Seekable read-only file object of remote file.
+
+    Content is read using range requests, so only read parts of the file
+    are downloaded. Each request reads at least 'block_size' bytes which
+    are buffered for following reads. Can be used e.g. to read only
+    central directory and some members of remote zip archive.
+
+    Args:
+        url (str): Url of file.
+        headers (Optional[dict[str, str]]): Additional headers.
+        tail_size (Optional[int]): Size of end of file requested by first
+            request. Useful for zip archives which have index at the end.
+
+    Raises:
+        ValueError: Server does not support range requests.
+    """
+
+    block_size = 1024 * 1024
+    max_retries = 5
+    retry_delay = 1.0
+    timeout = 60
+
+    def __init__(self, url, headers=None, tail_size=64 * 1024):
+        final_headers = {"User-Agent": USER_AGENT}
+        if headers:
+            final_headers.update(headers)
+        self._url = url
+        self._headers = final_headers
+        self._position = 0
+        self._buffer = b""
+        self._buffer_start = 0
+        self._transferred = 0
+        self._size = None
+        self._fetch(f"-{tail_size}")
+
+    @property
+    def size(self):
+        return self._size
+
+    @property
+    def transferred(self):
+        """Number of downloaded bytes.
+
+        Returns:
+            int: Downloaded bytes.
+        """
+
+        return self._transferred
+
+    def seekable(self):
+        return True
+
+    def readable(self):
+        return True
+
+    def tell(self):
+        return self._position
+
+    def seek(self, offset, whence=os.SEEK_SET):
+        if whence == os.SEEK_CUR:
+            offset += self._position
+        elif whence == os.SEEK_END:
+            offset += self._size
+        if offset < 0:
+            raise ValueError("Negative seek position")
+        self._position = offset
+        return offset
+
+    def read(self, size=-1):
+        remaining = self._size - self._position
+        if size is None or size < 0 or size > remaining:
+            size = max(0, remaining)
+
+        chunks = []
+        while size > 0:
+            offset = self._position - self._buffer_start
+            if not 0 <= offset < len(self._buffer):
+                end = min(
+                    self._position + max(size, self.block_size),
+                    self._size
+                )
+                self._fetch(f"{self._position}-{end - 1}")
+                offset = 0
+            chunk = self._buffer[offset:offset + size]
+            chunks.append(chunk)
+            self._position += len(chunk)
+            size -= len(chunk)
+        return b"".join(chunks)
+
+    def prefetch(self, start, end):
+        """Download exact range of file to buffer.
+
+        Following reads inside of the range don't send requests. Useful
+        when ranges which will be read are known, so reads don't download
+        whole 'block_size' around them.
+
+        Args:
+            start (int): Start of range.
+            end (int): End of range (exclusive).
+        """
+
+        end = min(end, self._size)
+        buffer_end = self._buffer_start + len(self._buffer)
+        if start >= end or (
+            self._buffer_start <= start and end <= buffer_end
+        ):
+            return
+        self._fetch(f"{start}-{end - 1}")
+
+    def close(self):
+        self._buffer = b""
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _fetch(self, byte_range):
+        attempt = 0
+        while True:
+            try:
+                self._fetch_range(byte_range)
+                return
+            except RETRY_EXCEPTIONS:
+                attempt += 1
+                if attempt > self.max_retries:
+                    raise
+                time.sleep(self.retry_delay * attempt)
+
+    def _fetch_range(self, byte_range):
+        headers = dict(self._headers)
+        headers["Range"] = f"bytes={byte_range}"
+        with urllib.request.urlopen(
+            urllib.request.Request(self._url, headers=headers),
+            timeout=self.timeout
+        ) as response:
+            content_range = response.headers.get("Content-Range") or ""
+            match = re.match(r"bytes\s+(\d+)-(\d+)/(\d+)", content_range)
+            if response.status != 206 or match is None:
+                raise ValueError("Server does not support range requests")
+            start, end, size = (int(value) for value in match.groups())
+            content = response.read()
+
+        if len(content) != end + 1 - start:
+            raise http.client.IncompleteRead(
+                content, end + 1 - start - len(content)
+            )
+        self._size = size
+        self._buffer = content
+        self._buffer_start = start
+        self._transferred += len(content)
+
+
+def _write_at(fd, data, position):
+    """Write data to file descriptor at position.
+
+    Args:
+        fd (int): File descriptor. Must not be shared between threads
+            on platforms without 'os.pwrite'.
+        data (bytes): Data to write.
+        position (int): Position in file.
+    """
+
+    view = memoryview(data)
+    while view:
+        if hasattr(os, "pwrite"):
+            written = os.pwrite(fd, view, position)
+        else:
+            os.lseek(fd, position, os.SEEK_SET)
+            written = os.write(fd, view)
+        view = view[written:]
+        position += written
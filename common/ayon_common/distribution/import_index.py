@@ -0,0 +1,317 @@
+"""Index of top-level python modules available in distributed addons.
+
+Each directory in 'sys.path' adds filesystem lookups to every import of
+a module which is not imported yet. Addons and dependency package add
+dozens of directories to 'sys.path' which is slow on network homes.
+
+Index maps names of top-level modules and packages to directories (or
+zip archives) where they are. Index is built on distribution and stored
+in addons directory. 'IndexedPathFinder' uses the index to find module
+spec using only the directory where module is, so the directories don't
+have to be in 'sys.path'.
+
+Index is invalidated when list of directories or modification time of
+any of the directories changed. Each list of directories has own index
+file, so processes using different bundles don't rebuild the same file.
+"""
+
+import os
+import sys
+import json
+import uuid
+import hashlib
+import zipfile
+import importlib.machinery
+
+INDEX_VERSION = 1
+
+
+def is_import_index_enabled():
+    """Import finder using index is used instead of 'sys.path'.
+
+    Can be disabled with 'AYON_IMPORT_INDEX' environment variable set
+    to '0'.
+
+    Returns:
+        bool: Import index is enabled.
+    """
+
+    return os.getenv("AYON_IMPORT_INDEX") != "0"
+
+
+def get_import_index_filename(dirpaths):
+    """Name of index file for directories.
+
+    Args:
+        dirpaths (list[str]): Directories in order of their priority.
+
+    Returns:
+        str: Filename unique for the directories.
+    """
+
+    key = hashlib.sha256(
+        "\n".join(dirpaths).encode("utf-8")
+    ).hexdigest()
+    return f"import_index_{key[:16]}.json"
+
+
+def _get_module_name(filename):
+    for suffix in importlib.machinery.all_suffixes():
+        if filename.endswith(suffix):
+            name = filename[:-len(suffix)]
+            if name.isidentifier():
+                return name
+            return None
+    return None
+
+
+def _get_mtime(path):
+    try:
+        return os.stat(path).st_mtime_ns
+    except OSError:
+        return None
+
+
+def _get_dir_module_names(dirpath):
+    names = set()
+    for entry in os.scandir(dirpath):
+        if entry.is_dir():
+            if entry.name.isidentifier():
+                names.add(entry.name)
+            continue
+        name = _get_module_name(entry.name)
+        if name:
+            names.add(name)
+    return names
+
+
+def _get_zip_module_names(filepath):
+    names = set()
+    with zipfile.ZipFile(filepath) as zip_file:
+        for member_name in zip_file.namelist():
+            parts = member_name.split("/")
+            if len(parts) > 1:
+                if parts[0].isidentifier():
+                    names.add(parts[0])
+                continue
+            name = _get_module_name(member_name)
+            if name:
+                names.add(name)
+    return names
+
+
+def build_import_index(dirpaths):
+    """Build index of top-level modules in directories.
+
+    Args:
+        dirpaths (list[str]): Directories or zip archives in order of
+            their priority.
+
+    Returns:
+        dict[str, Any]: Import index.
+    """
+
+    roots = []
+    modules = {}
+    for idx, dirpath in enumerate(dirpaths):
+        roots.append({"path": dirpath, "mtime": _get_mtime(dirpath)})
+        try:
+            if os.path.isfile(dirpath):
+                names = _get_zip_module_names(dirpath)
+            else:
+                names = _get_dir_module_names(dirpath)
+        except (OSError, zipfile.BadZipFile):
+            continue
+
+        for name in names:
+            modules.setdefault(name, []).append(idx)
+
+    return {
+        "version": INDEX_VERSION,
+        "roots": roots,
+        "modules": modules,
+    }
+
+
+def is_import_index_valid(index, dirpaths):
+    """Index was built for directories and they did not change.
+
+    Args:
+        index (dict[str, Any]): Import index.
+        dirpaths (list[str]): Directories in order of their priority.
+
+    Returns:
+        bool: Index can be used.
+    """
+
+    if index.get("version") != INDEX_VERSION:
+        return False
+    roots = index.get("roots") or []
+    if [root["path"] for root in roots] != list(dirpaths):
+        return False
+    return all(
+        root["mtime"] == _get_mtime(root["path"])
+        for root in roots
+    )
+
+
+def load_import_index(filepath, dirpaths):
+    """Load stored index if is valid for directories.
+
+    Args:
+        filepath (str): Path to index file.
+        dirpaths (list[str]): Directories in order of their priority.
+
+    Returns:
+        Union[dict[str, Any], None]: Import index or None if is not
+            available or is outdated.
+    """
+
+    if not os.path.exists(filepath):
+        return None
+    try:
+        with open(filepath, "r") as stream:
+            index = json.load(stream)
+    except (OSError, ValueError):
+        return None
+
+    if is_import_index_valid(index, dirpaths):
+        return index
+    return None
+
+
+def save_import_index(filepath, index):
+    """Store import index.
+
+    Args:
+        filepath (str): Path to index file.
+        index (dict[str, Any]): Import index.
+    """
+
+    os.makedirs(os.path.dirname(filepath), exist_ok=True)
+    # Other processes may read the index at the same time
+    tmp_path = f"{filepath}.{uuid.uuid4().hex}.tmp"
+    try:
+        with open(tmp_path, "w") as stream:
+            json.dump(index, stream)
+        os.replace(tmp_path, filepath)
+    finally:
+        if os.path.exists(tmp_path):
+            os.remove(tmp_path)
+
+
+def update_import_index(filepath, dirpaths):
+    """Load index or build a new one if stored is outdated.
+
+    Args:
+        filepath (str): Path to index file.
+        dirpaths (list[str]): Directories in order of their priority.
+
+    Returns:
+        dict[str, Any]: Import index.
+    """
+
+    index = load_import_index(filepath, dirpaths)
+    if index is None:
+        index = build_import_index(dirpaths)
+        save_import_index(filepath, index)
+    return index
+
+
+class IndexedPathFinder:
+    """Meta path finder resolving top-level modules using import index.
+
+    Module is looked up by 'PathFinder' only in directories where the
+    index found it, so path hooks handle both directories and zip
+    archives. Submodules are found by import system using '__path__'
+    of their parent package.
+
+    Args:
+        index (dict[str, Any]): Import index.
+    """
+
+    def __init__(self, index):
+        self._roots = [root["path"] for root in index["roots"]]
+        self._modules = index["modules"]
+
+    @property
+    def roots(self):
+        return list(self._roots)
+
+    def find_spec(self, fullname, path=None, target=None):
+        if path is not None:
+            return None
+        root_indexes = self._modules.get(fullname)
+        if not root_indexes:
+            return None
+
+        # Same rules as 'PathFinder' - first module or regular package
+        #   wins, namespace portions are merged
+        namespace_paths = []
+        for idx in root_indexes:
+            spec = importlib.machinery.PathFinder.find_spec(
+                fullname, [self._roots[idx]], target
+            )
+            if spec is None:
+                continue
+            if spec.loader is not None:
+                return spec
+            namespace_paths.extend(spec.submodule_search_locations or [])
+
+        if not namespace_paths:
+            return None
+
+        # Module or regular package in 'sys.path' wins over namespace
+        #   portions in index, other portions are merged
+        sys_spec = importlib.machinery.PathFinder.find_spec(
+            fullname, sys.path, target
+        )
+        if sys_spec is not None:
+            if sys_spec.loader is not None:
+                return sys_spec
+            for path in sys_spec.submodule_search_locations or []:
+                if path not in namespace_paths:
+                    namespace_paths.append(path)
+
+        spec = importlib.machinery.ModuleSpec(
+            fullname, None, is_package=True
+        )
+        spec.submodule_search_locations = namespace_paths
+        return spec
+
+
+def install_import_finder(index):
+    """Add finder using import index to 'sys.meta_path'.
+
+    Finder is added before 'PathFinder', so modules in index have higher
+    priority than modules in 'sys.path' but builtin and frozen modules
+    can't be overridden. Directories which should have priority over
+    indexed modules must be part of the index, in front of them, even if
+    they are in 'sys.path'. Previously installed finder is replaced.
+
+    Args:
+        index (dict[str, Any]): Import index.
+
+    Returns:
+        IndexedPathFinder: Installed finder.
+    """
+
+    uninstall_import_finder()
+    finder = IndexedPathFinder(index)
+    insert_idx = len(sys.meta_path)
+    for idx, meta_finder in enumerate(sys.meta_path):
+        if meta_finder is importlib.machinery.PathFinder:
+            insert_idx = idx
+            break
+    sys.meta_path.insert(insert_idx, finder)
+    return finder
+
+
+def uninstall_import_finder():
+    """Remove finders using import index from 'sys.meta_path'."""
+
+    sys.meta_path[:] = [
+        finder
+        for finder in sys.meta_path
+        if not isinstance(finder, IndexedPathFinder)
+    ]
@@ -0,0 +1,191 @@
+"""Cross-process locks of distributed items.
+
+Multiple launcher processes can distribute the same addon or dependency
+package at the same time, e.g. when multiple applications are started
+at once. Each item is distributed under exclusive lock of a lock file
+next to its directory. Process which has to wait for the lock reuses
+result of the process which held the lock instead of downloading
+and extracting the item again.
+
+Lock is released by the operating system when the process holding it
+ends, so lock of crashed process does not block other processes.
+
+Result of distribution is stored to the lock file while the lock is
+held. On Windows the file is locked using 'msvcrt' which locks byte
+ranges, so a byte far behind the content is locked and the content
+can be read by other processes.
+"""
+
+import os
+import json
+import time
+import platform
+
+from .exceptions import DistributionLockTimeoutError
+
+if platform.system().lower() == "windows":
+    import msvcrt
+
+    fcntl = None
+else:
+    import fcntl
+
+    msvcrt = None
+
+# Seconds between attempts to acquire lock held by other process
+LOCK_POLL_INTERVAL = 0.1
+# Seconds to wait for other process before distribution fails
+DEFAULT_LOCK_TIMEOUT = 60 * 60
+# Offset of locked byte on Windows
+_MSVCRT_LOCK_OFFSET = 2 ** 30
+
+
+def get_lock_timeout():
+    """Maximum time to wait for other process distributing the same item.
+
+    Timeout in seconds can be changed with
+    'AYON_DISTRIBUTION_LOCK_TIMEOUT' environment variable.
+
+    Returns:
+        float: Timeout in seconds.
+    """
+
+    value = os.getenv("AYON_DISTRIBUTION_LOCK_TIMEOUT")
+    if value:
+        try:
+            return max(0.0, float(value))
+        except ValueError:
+            pass
+    return float(DEFAULT_LOCK_TIMEOUT)
+
+
+def _try_lock(fd):
+    try:
+        if msvcrt is not None:
+            os.lseek(fd, _MSVCRT_LOCK_OFFSET, os.SEEK_SET)
+            msvcrt.locking(fd, msvcrt.LK_NBLCK, 1)
+        else:
+            fcntl.flock(fd, fcntl.LOCK_EX | fcntl.LOCK_NB)
+    except OSError:
+        return False
+    return True
+
+
+def _unlock(fd):
+    if msvcrt is not None:
+        os.lseek(fd, _MSVCRT_LOCK_OFFSET, os.SEEK_SET)
+        msvcrt.locking(fd, msvcrt.LK_UNLCK, 1)
+    else:
+        fcntl.flock(fd, fcntl.LOCK_UN)
+
+
+class ItemLock:
+    """Exclusive lock of distributed item shared by processes.
+
+    Lock is not reentrant and must not be shared by threads.
+
+    Args:
+        filepath (str): Path to lock file.
+    """
+
+    def __init__(self, filepath):
+        self._filepath = filepath
+        self._fd = None
+
+    @property
+    def filepath(self):
+        return self._filepath
+
+    @property
+    def is_locked(self):
+        return self._fd is not None
+
+    def _open(self):
+        dirpath = os.path.dirname(self._filepath)
+        if dirpath:
+            os.makedirs(dirpath, exist_ok=True)
+        return os.open(self._filepath, os.O_RDWR | os.O_CREAT, 0o666)
+
+    def try_acquire(self):
+        """Acquire lock if is not held by other process.
+
+        Returns:
+            bool: Lock was acquired.
+        """
+
+        if self._fd is not None:
+            return True
+
+        fd = self._open()
+        if not _try_lock(fd):
+            os.close(fd)
+            return False
+        self._fd = fd
+        return True
+
+    def acquire(self, timeout=None):
+        """Wait until lock is acquired.
+
+        Args:
+            timeout (Optional[float]): Maximum time to wait in seconds.
+                Wait without limit if not passed.
+
+        Raises:
+            DistributionLockTimeoutError: Lock was not acquired in time.
+        """
+
+        start_time = time.monotonic()
+        while not self.try_acquire():
+            if (
+                timeout is not None
+                and time.monotonic() - start_time >= timeout
+            ):
+                raise DistributionLockTimeoutError(self._filepath, timeout)
+            time.sleep(LOCK_POLL_INTERVAL)
+
+    def release(self):
+        """Release lock if is held."""
+
+        fd, self._fd = self._fd, None
+        if fd is None:
+            return
+        try:
+            _unlock(fd)
+        finally:
+            os.close(fd)
+
+    def read_result(self):
+        """Result of last successful distribution of the item.
+
+        Returns:
+            Union[dict[str, Any], None]: Result data or None if item
+                was not distributed under the lock yet.
+        """
+
+        try:
+            with open(self._filepath, "r") as stream:
+                data = json.load(stream)
+        except (OSError, ValueError):
+            return None
+        if not isinstance(data, dict):
+            return None
+        return data
+
+    def write_result(self, data):
+        """Store result of distribution for processes waiting for lock.
+
+        Args:
+            data (dict[str, Any]): Json serializable result data.
+
+        Raises:
+            RuntimeError: Lock is not held.
+        """
+
+        if self._fd is None:
+            raise RuntimeError(f"Lock '{self._filepath}' is not acquired")
+
+        content = json.dumps(data).encode("utf-8")
+        os.lseek(self._fd, 0, os.SEEK_SET)
+        os.ftruncate(self._fd, 0)
+        os.write(self._fd, content)
+        os.fsync(self._fd)
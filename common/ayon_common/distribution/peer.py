@@ -0,0 +1,181 @@
+"""Share artifacts cache with other machines in local network.
+
+Machine which has archives in artifacts cache can serve them to other
+machines, so only one machine has to download them from AYON server. Other
+machines use 'PeerDownloader' which asks peers defined in
+'AYON_DISTRIBUTION_PEERS' environment variable before the server is used.
+
+Only archives from artifacts cache are served. Archives in the cache were
+validated with checksum, and downloaded file is validated again on the
+machine which downloaded it.
+
+Server does not use any authentication, anybody who can connect to it
+can download the cached archives. It listens only on localhost by
+default, address of network interface must be passed explicitly to share
+the cache in trusted studio network.
+
+Run peer server:
+    ayon --skip-bootstrap <path to this file> --host 10.0.0.5 --port 8765
+"""
+
+import os
+import re
+import shutil
+import logging
+import argparse
+from http.server import ThreadingHTTPServer, BaseHTTPRequestHandler
+
+ARTIFACT_PATH_REGEX = re.compile(
+    r"^/artifacts/(?P<algorithm>[a-z0-9_]+)/(?P<checksum>[0-9a-fA-F]+)$"
+)
+DEFAULT_PEER_PORT = 8765
+DEFAULT_PEER_HOST = "127.0.0.1"
+
+
+def get_distribution_peers():
+    """Urls of peers which may have archives in artifacts cache.
+
+    Peers are defined in 'AYON_DISTRIBUTION_PEERS' environment variable
+    as comma separated urls or '<host>:<port>' values. It can be
+    a designated cache node in studio network or other workstations.
+
+    Returns:
+        list[str]: Urls of peers.
+    """
+
+    value = os.getenv("AYON_DISTRIBUTION_PEERS") or ""
+    output = []
+    for item in value.split(","):
+        item = item.strip().rstrip("/")
+        if not item:
+            continue
+        if "://" not in item:
+            if ":" not in item:
+                item = f"{item}:{DEFAULT_PEER_PORT}"
+            item = f"http://{item}"
+        output.append(item)
+    return output
+
+
+def get_artifact_url(peer_url, checksum, checksum_algorithm):
+    """Url of an artifact on peer.
+
+    Args:
+        peer_url (str): Url of peer.
+        checksum (str): Checksum of artifact.
+        checksum_algorithm (str): Algorithm of checksum.
+
+    Returns:
+        str: Url of artifact.
+    """
+
+    return f"{peer_url}/artifacts/{checksum_algorithm}/{checksum}"
+
+
+class _ArtifactRequestHandler(BaseHTTPRequestHandler):
+    server_version = "AYON-peer"
+
+    def log_message(self, fmt, *args):
+        self.server.log.debug(fmt, *args)
+
+    def _get_artifact(self):
+        match = ARTIFACT_PATH_REGEX.match(self.path)
+        if match is None:
+            return None
+        return self.server.artifact_cache.get(
+            match.group("checksum").lower(), match.group("algorithm")
+        )
+
+    def _send_headers(self, filepath):
+        # Artifact is stored in directory named by checksum
+        checksum = os.path.basename(os.path.dirname(filepath))
+        self.send_response(200)
+        self.send_header("Content-Type", "application/octet-stream")
+        self.send_header("Content-Length", str(os.path.getsize(filepath)))
+        self.send_header("ETag", f'"{checksum}"')
+        self.send_header(
+            "Content-Disposition",
+            f'attachment; filename="{os.path.basename(filepath)}"'
+        )
+        self.end_headers()
+
+    def do_HEAD(self):
+        filepath = self._get_artifact()
+        if not filepath:
+            self.send_error(404)
+            return
+        self._send_headers(filepath)
+
+    def do_GET(self):
+        filepath = self._get_artifact()
+        if not filepath:
+            self.send_error(404)
+            return
+        with open(filepath, "rb") as stream:
+            self._send_headers(filepath)
+            shutil.copyfileobj(stream, self.wfile, 1024 * 1024)
+
+
+class ArtifactPeerServer(ThreadingHTTPServer):
+    """HTTP server sharing artifacts cache with other machines.
+
+    Args:
+        artifact_cache (ArtifactCache): Cache with archives to share.
+        host (Optional[str]): Host to listen on. Only localhost by default.
+        port (Optional[int]): Port to listen on. Use '0' to pick free port.
+    """
+
+    daemon_threads = True
+
+    def __init__(
+        self, artifact_cache, host=DEFAULT_PEER_HOST, port=DEFAULT_PEER_PORT
+    ):
+        self.artifact_cache = artifact_cache
+        self.log = logging.getLogger(self.__class__.__name__)
+        super().__init__((host, port), _ArtifactRequestHandler)
+
+    @property
+    def port(self):
+        return self.server_address[1]
+
+
+def main():
+    from ayon_common.distribution.cache import ArtifactCache
+
+    parser = argparse.ArgumentParser(
+        description="Share AYON artifacts cache with other machines."
+    )
+    parser.add_argument(
+        "--host",
+        default=DEFAULT_PEER_HOST,
+        help=(
+            "Address to listen on. Server is not authenticated, use"
+            " address of interface in trusted network."
+        )
+    )
+    parser.add_argument("--port", type=int, default=DEFAULT_PEER_PORT)
+    parser.add_argument(
+        "--cache-dir",
+        default=None,
+        help="Artifacts cache directory. Default cache is used if not set."
+    )
+    # Path to this script may be in arguments when launched via AYON
+    args, _ = parser.parse_known_args()
+
+    server = ArtifactPeerServer(
+        ArtifactCache(root=args.cache_dir), args.host, args.port
+    )
+    print(
+        f"Serving artifacts from {server.artifact_cache.root}"
+        f" on {args.host}:{server.port}"
+    )
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.server_close()
+
+
+if __name__ == "__main__":
+    main()
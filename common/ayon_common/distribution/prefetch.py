@@ -0,0 +1,208 @@
+"""Background pre-distribution of production and staging bundles.
+
+Prefetch daemon periodically checks bundles on server and distributes
+addons and dependency packages of production and staging bundles when
+they changed. Items are distributed the same way as on launcher boot,
+so they are marked as distributed in metadata store and launcher which
+starts with the bundle does not have to distribute anything.
+
+Daemon runs with lower process priority and distributes only few items
+at the same time to not slow down work of the user. Items are
+distributed under cross-process locks, so launcher started while the
+daemon distributes an item waits for it and reuses its result.
+
+Only one daemon runs for a user on a machine.
+"""
+
+import os
+import json
+import ctypes
+import logging
+import platform
+import threading
+
+import ayon_api
+
+from ayon_common.utils import get_ayon_appdirs
+
+from .control import AyonDistribution
+from .locks import ItemLock
+
+# Seconds between checks of bundles on server
+DEFAULT_PREFETCH_INTERVAL = 5 * 60
+# Items distributed at the same time
+PREFETCH_MAX_WORKERS = 2
+# Lowers CPU, I/O and memory priority of current process on Windows
+_PROCESS_MODE_BACKGROUND_BEGIN = 0x00100000
+# Added to niceness of process on other platforms
+_PREFETCH_NICENESS = 10
+
+
+def get_prefetch_interval():
+    """Time between checks of bundles on server.
+
+    Interval in seconds can be changed with 'AYON_PREFETCH_INTERVAL'
+    environment variable.
+
+    Returns:
+        float: Interval in seconds.
+    """
+
+    value = os.getenv("AYON_PREFETCH_INTERVAL")
+    if value:
+        try:
+            return max(1.0, float(value))
+        except ValueError:
+            pass
+    return float(DEFAULT_PREFETCH_INTERVAL)
+
+
+def lower_process_priority():
+    """Lower scheduling priority of current process.
+
+    Returns:
+        bool: Priority was lowered.
+    """
+
+    try:
+        if platform.system().lower() == "windows":
+            kernel32 = ctypes.windll.kernel32
+            return bool(kernel32.SetPriorityClass(
+                kernel32.GetCurrentProcess(),
+                _PROCESS_MODE_BACKGROUND_BEGIN
+            ))
+        os.nice(_PREFETCH_NICENESS)
+    except Exception:
+        return False
+    return True
+
+
+class PrefetchDaemon:
+    """Distribute production and staging bundles before they are used.
+
+    Args:
+        interval (Optional[float]): Seconds between checks of bundles on
+            server. Value of 'get_prefetch_interval' is used if not passed.
+        max_workers (Optional[int]): Items distributed at the same time.
+        distribution_kwargs (Optional[dict[str, Any]]): Additional
+            arguments for 'AyonDistribution'.
+        logger (Optional[logging.Logger]): Logger object.
+    """
+
+    def __init__(
+        self,
+        interval=None,
+        max_workers=PREFETCH_MAX_WORKERS,
+        distribution_kwargs=None,
+        logger=None,
+    ):
+        if interval is None:
+            interval = get_prefetch_interval()
+        if logger is None:
+            logger = logging.getLogger(self.__class__.__name__)
+        self.log = logger
+        self._interval = interval
+        self._max_workers = max_workers
+        self._distribution_kwargs = distribution_kwargs or {}
+        self._stop_event = threading.Event()
+        # Bundles which were fully distributed by last prefetch
+        self._last_signature = None
+
+    def stop(self):
+        """Stop daemon after current prefetch."""
+
+        self._stop_event.set()
+
+    def _prefetch_bundle(self, bundle_name, bundles_info):
+        """Distribute addons and dependency package of a bundle.
+
+        Args:
+            bundle_name (str): Name of bundle.
+            bundles_info (dict[str, Any]): Bundles information from server.
+
+        Returns:
+            bool: All items of bundle are distributed.
+        """
+
+        distribution = AyonDistribution(
+            bundle_name=bundle_name,
+            bundles_info=bundles_info,
+            skip_installer_dist=True,
+            **self._distribution_kwargs
+        )
+        try:
+            distribution.prefetch_server_data()
+            if not distribution.need_distribution:
+                return True
+
+            self.log.info(f"Prefetching bundle '{bundle_name}'")
+            distribution.distribute(
+                threaded=True, max_workers=self._max_workers
+            )
+            distribution.validate_distribution()
+
+        except Exception:
+            self.log.warning(
+                f"Failed to prefetch bundle '{bundle_name}'", exc_info=True
+            )
+            return False
+
+        self.log.info(f"Bundle '{bundle_name}' is prefetched")
+        return True
+
+    def prefetch(self):
+        """Distribute production and staging bundles if they changed.
+
+        Returns:
+            bool: All items of the bundles are distributed.
+        """
+
+        bundles_info = ayon_api.get_bundles()
+        bundles = [
+            bundle
+            for bundle in bundles_info["bundles"]
+            if bundle.get("isProduction") or bundle.get("isStaging")
+        ]
+        signature = json.dumps(bundles, sort_keys=True)
+        if signature == self._last_signature:
+            return True
+
+        success = True
+        for bundle in bundles:
+            if self._stop_event.is_set():
+                return False
+            if not self._prefetch_bundle(bundle["name"], bundles_info):
+                success = False
+
+        # Failed bundles are prefetched again on next check
+        if success:
+            self._last_signature = signature
+        return success
+
+    def run(self):
+        """Check bundles on server until daemon is stopped.
+
+        Returns:
+            bool: Daemon was running, False if other daemon is running.
+        """
+
+        lock = ItemLock(get_ayon_appdirs("prefetch_daemon.lock"))
+        if not lock.try_acquire():
+            self.log.info("Prefetch daemon is already running")
+            return False
+
+        try:
+            if not lower_process_priority():
+                self.log.debug("Failed to lower process priority")
+
+            while not self._stop_event.is_set():
+                try:
+                    self.prefetch()
+                except Exception:
+                    self.log.warning(
+                        "Failed to check bundles on server", exc_info=True
+                    )
+                self._stop_event.wait(self._interval)
+        finally:
+            lock.release()
+        return True
@@ -0,0 +1,238 @@
+"""Progress of distribution shared with update window process.
+
+'DistributionProgressTracker' collects distribution events and computes
+overall progress with transfer speed and estimated remaining time.
+
+Progress is sent to update window process through its stdin as json
+lines, see 'ayon_common.progress_channel'. Pipe does not need any port
+or shared memory name, works on all platforms and is closed
+automatically when any of processes ends.
+"""
+
+import time
+import threading
+import collections
+
+from ayon_common.progress_channel import write_progress
+
+from .events import DistributionEventTopic
+
+# Transfer speed is calculated from samples in this time window
+SPEED_WINDOW = 3.0
+# Progress is not sent to update window more often
+SEND_INTERVAL = 0.2
+
+
+class DistributionProgressTracker:
+    """Overall progress of distribution built from distribution events.
+
+    Can be registered as event callback of 'AyonDistribution'. Methods are
+    thread safe.
+    """
+
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._items = collections.OrderedDict()
+        self._finished = False
+        self._samples = collections.deque()
+        self._changed = threading.Condition(self._lock)
+        self._version = 0
+
+    def _get_item(self, label):
+        item = self._items.get(label)
+        if item is None:
+            item = {
+                "label": label,
+                "state": "waiting",
+                "phase": None,
+                "transferred": 0,
+                "size": None,
+                "unzipped": 0,
+                "unzip_size": None,
+            }
+            self._items[label] = item
+        return item
+
+    def __call__(self, event):
+        self.process_event(event)
+
+    def process_event(self, event):
+        """Update progress using distribution event.
+
+        Args:
+            event (DistributionEvent): Distribution event.
+        """
+
+        topic = event.topic
+        data = event.data
+        with self._lock:
+            if topic == DistributionEventTopic.DISTRIBUTION_STARTED:
+                for label in data["items"]:
+                    self._get_item(label)
+
+            elif topic == DistributionEventTopic.DISTRIBUTION_FINISHED:
+                self._finished = True
+
+            elif event.item_label is not None:
+                self._process_item_event(
+                    self._get_item(event.item_label), topic, data
+                )
+
+            self._version += 1
+            self._changed.notify_all()
+
+    def _process_item_event(self, item, topic, data):
+        if topic == DistributionEventTopic.ITEM_STARTED:
+            item["state"] = "running"
+
+        elif topic == DistributionEventTopic.ITEM_FINISHED:
+            item["state"] = data["state"]
+            item["phase"] = None
+
+        elif topic == DistributionEventTopic.SOURCE_STARTED:
+            # Other source is used after failed source
+            item["transferred"] = 0
+            item["size"] = None
+            item["unzipped"] = 0
+            item["unzip_size"] = None
+
+        elif topic == DistributionEventTopic.PHASE_STARTED:
+            item["phase"] = data["phase"]
+
+        elif topic == DistributionEventTopic.TRANSFER_PROGRESS:
+            item["transferred"] = data["transferred_size"]
+            item["size"] = data["content_size"]
+
+        elif topic == DistributionEventTopic.UNZIP_PROGRESS:
+            item["unzipped"] = data["transferred_size"]
+            item["unzip_size"] = data["content_size"]
+
+    def _get_speed(self, transferred):
+        now = time.monotonic()
+        samples = self._samples
+        samples.append((now, transferred))
+        while len(samples) > 2 and now - samples[0][0] > SPEED_WINDOW:
+            samples.popleft()
+        start_time, start_transferred = samples[0]
+        if now - start_time <= 0:
+            return None
+        return (transferred - start_transferred) / (now - start_time)
+
+    def get_snapshot(self):
+        """Current progress of distribution.
+
+        Returns:
+            dict[str, Any]: Progress data with items, transferred bytes,
+                transfer speed in bytes per second and estimated time
+                to finish download in seconds.
+        """
+
+        with self._lock:
+            return self._get_snapshot()
+
+    def _get_snapshot(self):
+        items = [dict(item) for item in self._items.values()]
+        transferred = sum(item["transferred"] for item in items)
+        size = None
+        remaining = 0
+        for item in items:
+            item_size = item["size"]
+            if item_size is None:
+                # Only received bytes of items without known size are
+                #   counted, finished items are complete (e.g. reused
+                #   from cache)
+                item_size = item["transferred"]
+                is_finished = item["state"] not in ("waiting", "running")
+                if not item_size and not is_finished:
+                    continue
+            remaining += max(0, item_size - item["transferred"])
+            size = (size or 0) + item_size
+
+        speed = self._get_speed(transferred)
+        eta = None
+        if size is not None and speed:
+            eta = remaining / speed
+        return {
+            "items": items,
+            "transferred": transferred,
+            "size": size,
+            "speed": speed,
+            "eta": eta,
+            "finished": self._finished,
+        }
+
+    def wait_for_change(self, version, timeout=None):
+        """Block until progress changes.
+
+        Args:
+            version (int): Version returned by previous call.
+            timeout (Optional[float]): Maximum time to wait.
+
+        Returns:
+            tuple[int, Union[dict[str, Any], None]]: New version with
+                progress snapshot or None on timeout.
+        """
+
+        with self._lock:
+            if self._version == version:
+                self._changed.wait(timeout)
+            if self._version == version:
+                return version, None
+            return self._version, self._get_snapshot()
+
+
+class ProgressChannelSender:
+    """Send progress of tracker to stream in background thread.
+
+    Progress is sent only when it changed and at most once per
+    'SEND_INTERVAL'. Sending stops silently when stream is closed
+    by reader.
+
+    Args:
+        tracker (DistributionProgressTracker): Progress tracker.
+        stream (BinaryIO): Writable stream, e.g. stdin of process.
+    """
+
+    def __init__(self, tracker, stream):
+        self._tracker = tracker
+        self._stream = stream
+        self._stopped = threading.Event()
+        self._thread = threading.Thread(
+            target=self._run,
+            name="ayon_progress_channel",
+            daemon=True
+        )
+
+    def start(self):
+        self._thread.start()
+
+    def stop(self, timeout=1.0):
+        """Stop sending and send last progress.
+
+        Args:
+            timeout (Optional[float]): Maximum time to wait.
+        """
+
+        self._stopped.set()
+        self._thread.join(timeout)
+
+    def _run(self):
+        version = -1
+        while True:
+            stopped = self._stopped.is_set()
+            version, snapshot = self._tracker.wait_for_change(
+                version, timeout=SEND_INTERVAL
+            )
+            if snapshot is not None and not self._send(snapshot):
+                return
+            if stopped:
+                return
+            self._stopped.wait(SEND_INTERVAL)
+
+    def _send(self, snapshot):
+        try:
+            write_progress(self._stream, snapshot)
+        except (OSError, ValueError):
+            return False
+        return True
+
@@ -0,0 +1,126 @@
+import os
+import logging
+import threading
+import contextlib
+from enum import Enum
+from concurrent.futures import ThreadPoolExecutor, as_completed
+
+
+class DistributionPhase(Enum):
+    DOWNLOAD = "download"
+    HASH_CHECK = "hash_check"
+    EXTRACT = "extract"
+    COMPILE = "compile"
+    # Other process distributes the same item, is not limited
+    WAIT = "wait"
+
+
+def _get_default_phase_limits():
+    cpu_count = os.cpu_count() or 1
+    return {
+        # Network bound - more streams help until link is saturated
+        DistributionPhase.DOWNLOAD: 4,
+        # CPU bound - 'hashlib' releases GIL for bigger chunks
+        DistributionPhase.HASH_CHECK: cpu_count,
+        # Disk bound - too many concurrent extractions fight for disk
+        DistributionPhase.EXTRACT: max(1, cpu_count // 2),
+        # Compilation of single item uses multiple processes
+        DistributionPhase.COMPILE: 1,
+    }
+
+
+class DistributionScheduler:
+    """Run distribution items in a bounded pool of worker threads.
+
+    Each distribution phase (download, hash check, extraction, compilation)
+    has own concurrency limit. Distribution item asks for a phase slot
+    using 'phase_slot' so e.g. extraction of a big dependency package does
+    not block download of addons.
+
+    Items are started in order of their 'priority' (higher first), so
+    dependency package, which is usually the biggest item, starts as first.
+
+    Waiting for items does not poll, calling thread is blocked until
+    futures of items signal their completion.
+
+    Args:
+        max_workers (Optional[int]): Maximum number of items distributed
+            at the same time.
+        phase_limits (Optional[dict[DistributionPhase, int]]): Concurrency
+            limit per distribution phase. Missing phases use default limits.
+        logger (Optional[logging.Logger]): Logger object.
+    """
+
+    def __init__(self, max_workers=None, phase_limits=None, logger=None):
+        limits = _get_default_phase_limits()
+        if phase_limits:
+            limits.update(phase_limits)
+
+        if max_workers is None:
+            max_workers = min(32, sum(limits.values()))
+
+        if logger is None:
+            logger = logging.getLogger(self.__class__.__name__)
+
+        self.log = logger
+        self._max_workers = max(1, max_workers)
+        self._phase_semaphores = {
+            phase: threading.BoundedSemaphore(max(1, limit))
+            for phase, limit in limits.items()
+        }
+
+    @property
+    def max_workers(self):
+        return self._max_workers
+
+    @contextlib.contextmanager
+    def phase_slot(self, phase):
+        """Wait for free slot of a distribution phase.
+
+        Args:
+            phase (DistributionPhase): Phase which will be processed.
+        """
+
+        semaphore = self._phase_semaphores.get(phase)
+        if semaphore is None:
+            yield
+            return
+
+        with semaphore:
+            yield
+
+    def run(self, items):
+        """Distribute items and block until all of them are finished.
+
+        Args:
+            items (Iterable[BaseDistributionItem]): Items to distribute.
+        """
+
+        items = sorted(
+            (item for item in items if item.need_distribution),
+            key=lambda item: item.priority,
+            reverse=True
+        )
+        if not items:
+            return
+
+        for item in items:
+            item.set_scheduler(self)
+
+        workers = min(self._max_workers, len(items))
+        with ThreadPoolExecutor(
+            max_workers=workers,
+            thread_name_prefix="ayon_distribution"
+        ) as executor:
+            futures = [
+                executor.submit(item.distribute)
+                for item in items
+            ]
+            # Crashes are logged as soon as they happen
+            for future in as_completed(futures):
+                # 'distribute' catches all errors, this is just for safety
+                exc = future.exception()
+                if exc is not None:
+                    self.log.error(
+                        "Distribution worker crashed", exc_info=exc
+                    )
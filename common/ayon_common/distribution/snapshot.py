@@ -0,0 +1,240 @@
+"""Snapshot of server data used to resolve bundle on boot.
+
+Boot of AYON launcher needs bundles, addons, dependency packages,
+installers and user information from server. The data are stored after
+successful boot to a snapshot which is used by next boots until it
+expires. Fresh snapshot is validated only by single request for bundles,
+other data are used from the snapshot if bundles did not change.
+
+Offline boot mode ('AYON_BOOT_OFFLINE=1') uses fresh snapshot without
+any validation request.
+
+Snapshot is signed with user's token, so snapshot created with other
+token (or modified on disk) is ignored.
+"""
+
+import os
+import json
+import time
+import hmac
+import uuid
+import hashlib
+import logging
+
+import ayon_api
+from ayon_api.constants import SERVER_URL_ENV_KEY, SERVER_API_ENV_KEY
+
+from ayon_common.utils import get_ayon_appdirs
+
+SNAPSHOT_VERSION = 1
+# Seconds for which is snapshot used
+DEFAULT_SNAPSHOT_TTL = 60 * 60
+
+
+def get_boot_snapshot_ttl():
+    """Time in seconds for which is boot snapshot used.
+
+    Value can be changed with 'AYON_BOOT_SNAPSHOT_TTL' environment
+    variable. Value '0' disables boot snapshot.
+
+    Returns:
+        int: Time to live of snapshot in seconds.
+    """
+
+    value = os.getenv("AYON_BOOT_SNAPSHOT_TTL")
+    if value:
+        try:
+            return max(0, int(value))
+        except ValueError:
+            pass
+    return DEFAULT_SNAPSHOT_TTL
+
+
+def is_offline_boot_enabled():
+    """Fresh boot snapshot is used without validation request.
+
+    Returns:
+        bool: Offline boot is enabled.
+    """
+
+    return os.getenv("AYON_BOOT_OFFLINE") == "1"
+
+
+def _get_bundles_hash(bundles_info):
+    content = json.dumps(bundles_info, sort_keys=True)
+    return hashlib.sha256(content.encode("utf-8")).hexdigest()
+
+
+class BootSnapshot:
+    """Signed snapshot of server data used to resolve bundle.
+
+    Args:
+        server_url (str): Server url.
+        token (str): User's token used to sign the snapshot.
+        ttl (Optional[int]): Time to live of snapshot in seconds.
+    """
+
+    log = logging.getLogger("BootSnapshot")
+
+    def __init__(self, server_url, token, ttl=None):
+        if ttl is None:
+            ttl = get_boot_snapshot_ttl()
+        self._server_url = server_url.rstrip("/")
+        self._token = token
+        self._ttl = ttl
+
+    @classmethod
+    def from_environment(cls):
+        """Snapshot for server and token in environment variables.
+
+        Returns:
+            Union[BootSnapshot, None]: Snapshot or None if server url or
+                token are not set.
+        """
+
+        server_url = os.getenv(SERVER_URL_ENV_KEY)
+        token = os.getenv(SERVER_API_ENV_KEY)
+        if not server_url or not token:
+            return None
+        return cls(server_url, token)
+
+    @property
+    def enabled(self):
+        return self._ttl > 0
+
+    @property
+    def filepath(self):
+        # Each server and token combination has own snapshot
+        key = hashlib.sha256(
+            f"{self._server_url}\n{self._token}".encode("utf-8")
+        ).hexdigest()
+        return get_ayon_appdirs("boot_snapshots", f"{key[:32]}.json")
+
+    def _sign(self, payload):
+        return hmac.new(
+            self._token.encode("utf-8"),
+            payload.encode("utf-8"),
+            hashlib.sha256
+        ).hexdigest()
+
+    def load(self):
+        """Load data of valid and fresh snapshot.
+
+        Returns:
+            Union[dict[str, Any], None]: Snapshot data or None if snapshot
+                is not available, is expired or signature does not match.
+        """
+
+        filepath = self.filepath
+        if not self.enabled or not os.path.exists(filepath):
+            return None
+
+        try:
+            with open(filepath, "r") as stream:
+                content = json.load(stream)
+            payload = content["payload"]
+            signature = content["signature"]
+        except Exception:
+            self.log.debug("Failed to read boot snapshot", exc_info=True)
+            return None
+
+        if not hmac.compare_digest(self._sign(payload), signature):
+            self.log.debug("Boot snapshot signature does not match")
+            return None
+
+        payload = json.loads(payload)
+        if (
+            payload.get("version") != SNAPSHOT_VERSION
+            or payload.get("server_url") != self._server_url
+        ):
+            return None
+
+        age = time.time() - payload["created"]
+        if age < 0 or age > self._ttl:
+            return None
+        return payload["data"]
+
+    def save(self, data):
+        """Store snapshot data.
+
+        Args:
+            data (dict[str, Any]): Data from
+                'AyonDistribution.get_boot_snapshot_data'.
+        """
+
+        if not self.enabled:
+            return
+
+        data = dict(data)
+        data["bundles_hash"] = _get_bundles_hash(data["bundles_info"])
+        payload = json.dumps({
+            "version": SNAPSHOT_VERSION,
+            "server_url": self._server_url,
+            "created": time.time(),
+            "data": data,
+        })
+        filepath = self.filepath
+        os.makedirs(os.path.dirname(filepath), exist_ok=True)
+        tmp_path = f"{filepath}.{uuid.uuid4().hex}.tmp"
+        try:
+            with open(tmp_path, "w") as stream:
+                json.dump(
+                    {"payload": payload, "signature": self._sign(payload)},
+                    stream
+                )
+            os.replace(tmp_path, filepath)
+        finally:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+
+    def remove(self):
+        filepath = self.filepath
+        if os.path.exists(filepath):
+            os.remove(filepath)
+
+    def get_distribution_kwargs(self, offline=None):
+        """Arguments for 'AyonDistribution' from snapshot.
+
+        Bundles are requested from server unless offline boot is enabled.
+        Rest of data is used from snapshot only if bundles did not change.
+
+        Args:
+            offline (Optional[bool]): Use snapshot without validation
+                request. Value of 'is_offline_boot_enabled' is used
+                if not passed.
+
+        Returns:
+            Union[dict[str, Any], None]: Keyword arguments for
+                'AyonDistribution'. Empty if snapshot can't be used. None
+                if validation request failed and snapshot was removed,
+                token should be validated again.
+        """
+
+        data = self.load()
+        if data is None:
+            return {}
+
+        if offline is None:
+            offline = is_offline_boot_enabled()
+
+        bundles_hash = data.pop("bundles_hash")
+        if offline:
+            self.log.debug("Using boot snapshot without validation")
+            return data
+
+        try:
+            bundles_info = ayon_api.get_bundles()
+        except Exception:
+            # Token may be invalid, next boot will validate it
+            self.log.warning(
+                "Failed to validate boot snapshot", exc_info=True
+            )
+            self.remove()
+            return None
+
+        if _get_bundles_hash(bundles_info) != bundles_hash:
+            self.log.debug("Bundles changed since boot snapshot was created")
+            return {"bundles_info": bundles_info}
+
+        data["bundles_info"] = bundles_info
+        return data
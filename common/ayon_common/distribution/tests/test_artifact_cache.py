@@ -0,0 +1,58 @@
+import os
+import zipfile
+import hashlib
+import tempfile
+
+from common.ayon_common.distribution.cache import ArtifactCache
+from common.ayon_common.distribution.control import (
+    DistributionItem,
+    UpdateState,
+)
+from common.ayon_common.distribution.downloaders import (
+    get_default_download_factory,
+)
+
+
+def _create_item(tmp_dir, checksum, cache):
+    unzip_dir = os.path.join(tempfile.mkdtemp(dir=tmp_dir), "addon_1.0.0")
+    return DistributionItem(
+        unzip_dir,
+        unzip_dir,
+        UpdateState.OUTDATED,
+        checksum,
+        "sha256",
+        get_default_download_factory(),
+        [],
+        {},
+        "Addon 1.0.0",
+        artifact_cache=cache,
+    )
+
+
+def test_cached_archive_validation():
+    """Corrupted cached archive is not used and is removed from cache."""
+
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    zip_path = os.path.join(tmp_dir, "addon.zip")
+    with zipfile.ZipFile(zip_path, "w") as zip_file:
+        zip_file.writestr("addon/__init__.py", "")
+    with open(zip_path, "rb") as stream:
+        checksum = hashlib.sha256(stream.read()).hexdigest()
+
+    cache = ArtifactCache(os.path.join(tmp_dir, "cache"), 1024 ** 3)
+    cached_path = cache.add(zip_path, checksum, "sha256")
+    assert cache.is_verified(cached_path)
+
+    item = _create_item(tmp_dir, checksum, cache)
+    item.distribute()
+    assert item.state == UpdateState.UPDATED
+    assert item.used_source["type"] == "cache"
+
+    # Corrupted in place by other machine sharing the cache
+    with open(cached_path, "r+b") as stream:
+        stream.write(b"corrupted")
+
+    item = _create_item(tmp_dir, checksum, cache)
+    item.distribute()
+    assert item.state != UpdateState.UPDATED
+    assert cache.get(checksum, "sha256") is None
@@ -0,0 +1,74 @@
+import os
+import json
+import tempfile
+
+import ayon_api
+import pytest
+
+from common.ayon_common.distribution import snapshot as snapshot_module
+from common.ayon_common.distribution.snapshot import BootSnapshot
+
+BUNDLES_INFO = {"bundles": [{"name": "prod", "isProduction": True}]}
+SNAPSHOT_DATA = {
+    "bundles_info": BUNDLES_INFO,
+    "addons_info": [{"name": "core"}],
+    "dependency_packages_info": [],
+    "active_user": "artist",
+}
+
+
+@pytest.fixture
+def appdirs_root(monkeypatch):
+    root = tempfile.mkdtemp(prefix="ayon_test_")
+    monkeypatch.setattr(
+        snapshot_module,
+        "get_ayon_appdirs",
+        lambda *args: os.path.join(root, *args)
+    )
+    return root
+
+
+def test_snapshot_signature(appdirs_root):
+    """Snapshot is used only with the token which signed it."""
+
+    snapshot = BootSnapshot("https://ayon.local", "token", ttl=60)
+    snapshot.save(SNAPSHOT_DATA)
+    assert snapshot.load()["addons_info"] == [{"name": "core"}]
+
+    other_token = BootSnapshot("https://ayon.local", "other", ttl=60)
+    assert other_token.load() is None
+
+    # Modified content is ignored
+    with open(snapshot.filepath, "r") as stream:
+        content = json.load(stream)
+    content["payload"] = content["payload"].replace("artist", "admin")
+    with open(snapshot.filepath, "w") as stream:
+        json.dump(content, stream)
+    assert snapshot.load() is None
+
+    expired = BootSnapshot("https://ayon.local", "token", ttl=0)
+    assert expired.load() is None
+
+
+def test_snapshot_validation_by_bundles(appdirs_root, monkeypatch):
+    """Snapshot data are used only if bundles did not change."""
+
+    snapshot = BootSnapshot("https://ayon.local", "token", ttl=60)
+    snapshot.save(SNAPSHOT_DATA)
+
+    monkeypatch.setattr(ayon_api, "get_bundles", lambda: BUNDLES_INFO)
+    assert snapshot.get_distribution_kwargs(offline=False) == SNAPSHOT_DATA
+
+    changed = {"bundles": []}
+    monkeypatch.setattr(ayon_api, "get_bundles", lambda: changed)
+    assert snapshot.get_distribution_kwargs(offline=False) == {
+        "bundles_info": changed
+    }
+
+    # Failed validation removes snapshot
+    def _failing_get_bundles():
+        raise ValueError("Invalid token")
+
+    monkeypatch.setattr(ayon_api, "get_bundles", _failing_get_bundles)
+    assert snapshot.get_distribution_kwargs(offline=False) is None
+    assert snapshot.load() is None
@@ -0,0 +1,118 @@
+import os
+import zipfile
+import tempfile
+import threading
+
+from common.ayon_common.distribution.control import (
+    DistributionItem,
+    UpdateState,
+)
+from common.ayon_common.distribution.data_structures import (
+    LocalSourceInfo,
+    MultiPlatformValue,
+)
+from common.ayon_common.distribution.downloaders import (
+    get_default_download_factory,
+)
+from common.ayon_common.distribution.events import (
+    DistributionEvent,
+    DistributionEventHub,
+    DistributionEventTopic,
+)
+from common.ayon_common.distribution.progress import (
+    DistributionProgressTracker,
+    ProgressChannelSender,
+)
+from common.ayon_common.distribution.scheduler import DistributionScheduler
+from common.ayon_common.progress_channel import read_progress_channel
+
+
+def test_distribution_events():
+    """Events of distributed item are reported from worker thread."""
+
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    zip_path = os.path.join(tmp_dir, "addon.zip")
+    with zipfile.ZipFile(zip_path, "w") as zip_file:
+        zip_file.writestr("addon/__init__.py", "")
+
+    unzip_dir = os.path.join(tmp_dir, "addon_1.0.0")
+    source = LocalSourceInfo(
+        type="filesystem",
+        path=MultiPlatformValue(
+            windows=zip_path, linux=zip_path, darwin=zip_path
+        ),
+    )
+    item = DistributionItem(
+        unzip_dir,
+        unzip_dir,
+        UpdateState.OUTDATED,
+        None,
+        "sha256",
+        get_default_download_factory(),
+        [source],
+        {},
+        "Addon 1.0.0",
+    )
+
+    events = []
+    thread_names = set()
+
+    def callback(event):
+        events.append(event)
+        thread_names.add(threading.current_thread().name)
+
+    event_hub = DistributionEventHub()
+    event_hub.add_callback(callback)
+    item.set_event_hub(event_hub)
+    DistributionScheduler(max_workers=1).run([item])
+
+    assert item.state == UpdateState.UPDATED
+    topics = [event.topic for event in events]
+    assert topics[0] == DistributionEventTopic.ITEM_STARTED
+    assert topics[-1] == DistributionEventTopic.ITEM_FINISHED
+    assert events[-1].data["state"] == UpdateState.UPDATED.value
+    assert DistributionEventTopic.SOURCE_STARTED in topics
+    assert {
+        event.data["phase"]
+        for event in events
+        if event.topic == DistributionEventTopic.PHASE_FINISHED
+    } >= {"download", "extract"}
+    assert all(event.item_label == "Addon 1.0.0" for event in events)
+    assert threading.current_thread().name not in thread_names
+
+
+def test_progress_channel():
+    """Progress of distribution is sent through pipe."""
+
+    tracker = DistributionProgressTracker()
+    for topic, data in (
+        (
+            DistributionEventTopic.DISTRIBUTION_STARTED,
+            {"items": ["A", "B", "C"]},
+        ),
+        (DistributionEventTopic.ITEM_STARTED, {}),
+        (DistributionEventTopic.PHASE_STARTED, {"phase": "download"}),
+        (
+            DistributionEventTopic.TRANSFER_PROGRESS,
+            {"transferred_size": 256, "content_size": 1024},
+        ),
+    ):
+        item_label = None if "items" in data else "A"
+        tracker.process_event(DistributionEvent(topic, item_label, data))
+    # Item reused from cache does not report size, item "C" did not start
+    tracker.process_event(DistributionEvent(
+        DistributionEventTopic.ITEM_FINISHED, "B", {"state": "updated"}
+    ))
+
+    read_fd, write_fd = os.pipe()
+    with open(read_fd, "rb") as reader, open(write_fd, "wb") as writer:
+        sender = ProgressChannelSender(tracker, writer)
+        sender.start()
+        progress = next(read_progress_channel(reader))
+        sender.stop()
+
+    assert progress["transferred"] == 256
+    assert progress["size"] == 1024
+    assert progress["finished"] is False
+    assert progress["items"][0]["phase"] == "download"
+    assert progress["items"][0]["state"] == "running"
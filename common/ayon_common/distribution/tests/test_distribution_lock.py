@@ -0,0 +1,70 @@
+import os
+import time
+import tempfile
+import threading
+
+from common.ayon_common.distribution.control import (
+    DistributionItem,
+    UpdateState,
+)
+from common.ayon_common.distribution.data_structures import (
+    LocalSourceInfo,
+    MultiPlatformValue,
+)
+from common.ayon_common.distribution.downloaders import (
+    get_default_download_factory,
+)
+from common.ayon_common.distribution.locks import ItemLock
+from common.ayon_common.distribution.utils import get_sibling_dirpath
+
+
+def test_wait_for_other_process():
+    """Item waits for lock holder and reuses its result."""
+
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    # Source does not exist, item can be distributed only by reusing
+    #   result of lock holder
+    zip_path = os.path.join(tmp_dir, "missing.zip")
+    unzip_dir = os.path.join(tmp_dir, "addon_1.0.0")
+    source = LocalSourceInfo(
+        type="filesystem",
+        path=MultiPlatformValue(
+            windows=zip_path, linux=zip_path, darwin=zip_path
+        ),
+    )
+    item = DistributionItem(
+        unzip_dir,
+        unzip_dir,
+        UpdateState.OUTDATED,
+        "abc",
+        "sha256",
+        get_default_download_factory(),
+        [source],
+        {},
+        "Addon 1.0.0",
+    )
+
+    # Lock file descriptor of other process
+    other_lock = ItemLock(get_sibling_dirpath(unzip_dir, "lock"))
+    assert other_lock.try_acquire()
+
+    thread = threading.Thread(target=item.distribute)
+    thread.start()
+    time.sleep(0.5)
+    assert thread.is_alive(), "Item did not wait for lock"
+
+    os.makedirs(unzip_dir)
+    source_data = {"type": "server", "filename": "addon.zip"}
+    other_lock.write_result({
+        "source": source_data,
+        "checksum": "abc",
+        "checksum_algorithm": "sha256",
+    })
+    other_lock.release()
+    thread.join(10)
+
+    assert item.state == UpdateState.UPDATED
+    assert item.used_source == source_data
+    # Lock is released after distribution
+    assert other_lock.try_acquire()
+    other_lock.release()
@@ -0,0 +1,330 @@
+import io
+import os
+import re
+import tarfile
+import zipfile
+import hashlib
+import tempfile
+import threading
+from http.server import ThreadingHTTPServer, BaseHTTPRequestHandler
+
+import pytest
+
+from common.ayon_common.distribution.file_handler import (
+    RemoteFileHandler,
+    SegmentedFileDownload,
+    HTTPRangeReader,
+)
+from common.ayon_common.distribution.delta import (
+    get_zip_manifest,
+    write_manifest,
+    extract_zip_delta,
+)
+
+PAYLOAD = os.urandom(1024 * 1024)
+ETAG = '"payload-v1"'
+
+
+def _create_tar_payload():
+    stream = io.BytesIO()
+    with tarfile.open(fileobj=stream, mode="w:gz") as tar_file:
+        for idx in range(16):
+            content = os.urandom(64 * 1024)
+            info = tarfile.TarInfo(f"addon/file_{idx}.bin")
+            info.size = len(content)
+            tar_file.addfile(info, io.BytesIO(content))
+    return stream.getvalue()
+
+
+class FlakyHandler(BaseHTTPRequestHandler):
+    """Serve 'payload' and drop connection after 'drop_after' bytes."""
+
+    payload = PAYLOAD
+    drop_after = None
+    requests = []
+
+    def log_message(self, *args):
+        pass
+
+    def do_GET(self):
+        self.requests.append(dict(self.headers))
+        payload = self.payload
+        start = 0
+        end = len(payload) - 1
+        range_value = self.headers.get("Range")
+        if_range = self.headers.get("If-Range")
+        use_range = (
+            range_value is not None
+            and (if_range is None or if_range == ETAG)
+        )
+        if use_range:
+            match = re.match(r"bytes=(\d*)-(\d*)", range_value)
+            if not match.group(1):
+                # Suffix range
+                start = max(0, len(payload) - int(match.group(2)))
+            else:
+                start = int(match.group(1))
+                if match.group(2):
+                    end = min(end, int(match.group(2)))
+
+        content = payload[start:end + 1]
+        if use_range:
+            self.send_response(206)
+            self.send_header(
+                "Content-Range",
+                f"bytes {start}-{end}/{len(payload)}"
+            )
+        else:
+            self.send_response(200)
+        self.send_header("Content-Length", str(len(content)))
+        self.send_header("ETag", ETAG)
+        self.end_headers()
+
+        if self.drop_after is not None:
+            content = content[:self.drop_after]
+            self.close_connection = True
+        self.wfile.write(content)
+
+
+@pytest.fixture
+def flaky_server():
+    FlakyHandler.payload = PAYLOAD
+    FlakyHandler.requests = []
+    server = ThreadingHTTPServer(("127.0.0.1", 0), FlakyHandler)
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    yield server
+    server.shutdown()
+    server.server_close()
+
+
+@pytest.fixture
+def no_retry_delay(monkeypatch):
+    monkeypatch.setattr(RemoteFileHandler, "retry_delay", 0)
+    monkeypatch.setattr(RemoteFileHandler, "max_retries", 20)
+
+
+def test_resume_dropped_download(flaky_server, no_retry_delay):
+    """Download is finished using range requests after connection drops."""
+
+    FlakyHandler.drop_after = 200 * 1024
+    url = "http://127.0.0.1:{}/payload.zip".format(flaky_server.server_port)
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    filepath = os.path.join(tmp_dir, "payload.zip")
+
+    checksum = RemoteFileHandler._urlretrieve(
+        url, filepath, checksum_algorithm="sha256"
+    )
+
+    with open(filepath, "rb") as stream:
+        assert stream.read() == PAYLOAD, "Downloaded content is not valid"
+    assert checksum == hashlib.sha256(PAYLOAD).hexdigest()
+    assert not os.path.exists(filepath + ".part"), "Part file was kept"
+
+    range_requests = [
+        headers
+        for headers in FlakyHandler.requests
+        if "Range" in headers
+    ]
+    assert range_requests, "Download was not resumed"
+    assert all(
+        headers.get("If-Range") == ETAG
+        for headers in range_requests
+    ), "Resume is not validated with ETag"
+
+
+def test_resume_existing_part_file(
+    flaky_server, no_retry_delay, monkeypatch
+):
+    """Part file left by previous process is resumed."""
+
+    FlakyHandler.drop_after = 300 * 1024
+    url = "http://127.0.0.1:{}/payload.zip".format(flaky_server.server_port)
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    filepath = os.path.join(tmp_dir, "payload.zip")
+
+    # Previous process failed without retries
+    monkeypatch.setattr(RemoteFileHandler, "max_retries", 0)
+    with pytest.raises(Exception):
+        RemoteFileHandler._urlretrieve(url, filepath)
+    assert os.path.getsize(filepath + ".part") == 300 * 1024
+
+    FlakyHandler.drop_after = None
+    FlakyHandler.requests = []
+    checksum = RemoteFileHandler._urlretrieve(
+        url, filepath, checksum_algorithm="sha256"
+    )
+    assert checksum == hashlib.sha256(PAYLOAD).hexdigest()
+    assert FlakyHandler.requests[0]["Range"] == f"bytes={300 * 1024}-"
+
+
+def test_segmented_download(flaky_server, monkeypatch):
+    """File is downloaded using multiple range requests."""
+
+    monkeypatch.setattr(SegmentedFileDownload, "retry_delay", 0)
+    monkeypatch.setattr(SegmentedFileDownload, "chunk_size", 16 * 1024)
+    # Each segment is interrupted at least once
+    FlakyHandler.drop_after = 100 * 1024
+    url = "http://127.0.0.1:{}/payload.zip".format(flaky_server.server_port)
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    filepath = os.path.join(tmp_dir, "payload.zip")
+
+    download = SegmentedFileDownload(
+        url, filepath, segments=4, min_size=0, checksum_algorithm="sha256"
+    )
+    downloaded = download.download()
+
+    assert downloaded, "Segmented download was not used"
+    assert download.checksum == hashlib.sha256(PAYLOAD).hexdigest()
+    with open(filepath, "rb") as stream:
+        assert stream.read() == PAYLOAD, "Downloaded content is not valid"
+
+    ranges = {
+        headers["Range"]
+        for headers in FlakyHandler.requests
+        if "Range" in headers
+    }
+    assert "bytes=0-262143" in ranges, "File was not split to segments"
+
+
+def test_segmented_download_resume(flaky_server, monkeypatch):
+    """Failed segmented download keeps received segments."""
+
+    monkeypatch.setattr(SegmentedFileDownload, "retry_delay", 0)
+    monkeypatch.setattr(SegmentedFileDownload, "max_retries", 0)
+    monkeypatch.setattr(SegmentedFileDownload, "chunk_size", 16 * 1024)
+    FlakyHandler.drop_after = 100 * 1024
+    url = "http://127.0.0.1:{}/payload.zip".format(flaky_server.server_port)
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    filepath = os.path.join(tmp_dir, "payload.zip")
+
+    download = SegmentedFileDownload(url, filepath, segments=4, min_size=0)
+    with pytest.raises(Exception):
+        download.download()
+    assert download.has_partial_content, "Received segments were removed"
+    assert not os.path.exists(filepath + ".part")
+
+    FlakyHandler.drop_after = None
+    FlakyHandler.requests = []
+    download = SegmentedFileDownload(
+        url, filepath, segments=4, min_size=0, checksum_algorithm="sha256"
+    )
+    assert download.download()
+    assert download.checksum == hashlib.sha256(PAYLOAD).hexdigest()
+    with open(filepath, "rb") as stream:
+        assert stream.read() == PAYLOAD, "Downloaded content is not valid"
+    assert not download.has_partial_content
+    ranges = {
+        headers["Range"]
+        for headers in FlakyHandler.requests
+        if "Range" in headers
+    }
+    assert "bytes=0-262143" not in ranges, "Segment was downloaded again"
+
+
+def test_stream_extract_tar(flaky_server, no_retry_delay):
+    """Tar archive is extracted while downloaded and resumed on failure."""
+
+    payload = _create_tar_payload()
+    FlakyHandler.payload = payload
+    FlakyHandler.drop_after = 300 * 1024
+    url = "http://127.0.0.1:{}/addon.tar.gz".format(
+        flaky_server.server_port
+    )
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    dst_dir = os.path.join(tmp_dir, "addon_1.0.0")
+    archive_path = os.path.join(tmp_dir, "addon.tar.gz")
+
+    extracted = []
+    checksum = RemoteFileHandler.stream_extract_tar(
+        url,
+        dst_dir,
+        ".tar.gz",
+        checksum_algorithm="sha256",
+        progress_callback=extracted.append,
+        archive_path=archive_path,
+        chunk_size=16 * 1024,
+    )
+
+    assert checksum == hashlib.sha256(payload).hexdigest()
+    assert sum(extracted) == 16 * 64 * 1024
+    assert len(os.listdir(os.path.join(dst_dir, "addon"))) == 16
+    with open(archive_path, "rb") as stream:
+        assert stream.read() == payload, "Stored archive is not valid"
+
+
+def test_stream_extract_tar_unsafe_members(flaky_server):
+    """Members escaping destination directory are not extracted."""
+
+    FlakyHandler.drop_after = None
+    url = "http://127.0.0.1:{}/addon.tar".format(flaky_server.server_port)
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    dst_dir = os.path.join(tmp_dir, "addon_1.0.0")
+    escaped_path = os.path.join(tmp_dir, "escaped.txt")
+
+    symlink = tarfile.TarInfo("addon/link")
+    symlink.type = tarfile.SYMTYPE
+    symlink.linkname = "../../escaped.txt"
+    fifo = tarfile.TarInfo("addon/fifo")
+    fifo.type = tarfile.FIFOTYPE
+    for member in (tarfile.TarInfo("../escaped.txt"), symlink, fifo):
+        stream = io.BytesIO()
+        with tarfile.open(fileobj=stream, mode="w") as tar_file:
+            tar_file.addfile(tarfile.TarInfo("addon/valid.txt"))
+            tar_file.addfile(member, io.BytesIO())
+        FlakyHandler.payload = stream.getvalue()
+
+        with pytest.raises(ValueError):
+            RemoteFileHandler.stream_extract_tar(url, dst_dir, ".tar")
+        assert not os.path.lexists(escaped_path)
+        assert not os.path.lexists(os.path.join(dst_dir, member.name))
+
+
+def _create_zip_payload(files):
+    stream = io.BytesIO()
+    with zipfile.ZipFile(stream, "w") as zip_file:
+        for filename, content in files.items():
+            zip_file.writestr(filename, content)
+    return stream.getvalue()
+
+
+def test_zip_delta_update(flaky_server):
+    """Only changed members of remote zip archive are downloaded."""
+
+    FlakyHandler.drop_after = None
+    old_files = {
+        f"addon/file_{idx}.bin": os.urandom(256 * 1024)
+        for idx in range(8)
+    }
+    new_files = dict(old_files)
+    new_files["addon/file_3.bin"] = os.urandom(256 * 1024)
+    FlakyHandler.payload = _create_zip_payload(new_files)
+
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    base_dir = os.path.join(tmp_dir, "base")
+    dst_dir = os.path.join(tmp_dir, "new")
+    old_payload = io.BytesIO(_create_zip_payload(old_files))
+    with zipfile.ZipFile(old_payload) as zip_file:
+        zip_file.extractall(base_dir)
+        base_manifest = get_zip_manifest(zip_file)
+    write_manifest(base_dir, base_manifest)
+    # Modified file of previous version with the same size is not reused
+    with open(os.path.join(base_dir, "addon/file_5.bin"), "r+b") as stream:
+        stream.write(b"modified")
+
+    url = "http://127.0.0.1:{}/addon.zip".format(flaky_server.server_port)
+    with HTTPRangeReader(url) as reader:
+        reader.block_size = 64 * 1024
+        with zipfile.ZipFile(reader) as zip_file:
+            assert extract_zip_delta(
+                zip_file, base_dir, base_manifest, dst_dir
+            )
+        transferred = reader.transferred
+
+    for filename, content in new_files.items():
+        with open(os.path.join(dst_dir, filename), "rb") as stream:
+            assert stream.read() == content, f"{filename} is not valid"
+    # Changed and modified members are downloaded
+    assert transferred < len(FlakyHandler.payload) / 3, (
+        "Unchanged members were downloaded"
+    )
@@ -0,0 +1,124 @@
+import os
+import sys
+import tempfile
+
+import pytest
+
+from common.ayon_common.distribution.import_index import (
+    build_import_index,
+    get_import_index_filename,
+    update_import_index,
+    load_import_index,
+    install_import_finder,
+    uninstall_import_finder,
+)
+
+MODULE_NAMES = ("ayon_test_module", "ayon_test_package", "ayon_test_ns")
+
+
+def _write(filepath, content=""):
+    os.makedirs(os.path.dirname(filepath), exist_ok=True)
+    with open(filepath, "w") as stream:
+        stream.write(content)
+
+
+@pytest.fixture
+def roots():
+    root = tempfile.mkdtemp(prefix="ayon_test_")
+    first = os.path.join(root, "first")
+    second = os.path.join(root, "second")
+    _write(os.path.join(first, "ayon_test_module.py"), "VALUE = 'first'")
+    _write(os.path.join(second, "ayon_test_module.py"), "VALUE = 'second'")
+    _write(
+        os.path.join(second, "ayon_test_package", "__init__.py"),
+        "VALUE = 'package'"
+    )
+    _write(os.path.join(first, "ayon_test_ns", "a.py"), "VALUE = 'a'")
+    _write(os.path.join(second, "ayon_test_ns", "b.py"), "VALUE = 'b'")
+    yield [first, second]
+    uninstall_import_finder()
+    for name in list(sys.modules):
+        if name.split(".")[0] in MODULE_NAMES:
+            sys.modules.pop(name)
+
+
+def test_import_finder(roots):
+    """Modules are imported from directories which are not in 'sys.path'."""
+
+    install_import_finder(build_import_index(roots))
+
+    import ayon_test_module
+    import ayon_test_package
+    from ayon_test_ns import a, b
+
+    assert ayon_test_module.VALUE == "first"
+    assert ayon_test_package.VALUE == "package"
+    assert (a.VALUE, b.VALUE) == ("a", "b")
+    assert not any(path in sys.path for path in roots)
+
+
+def test_import_finder_namespace_in_sys_path(roots):
+    """Namespace portions in 'sys.path' are not hidden by index."""
+
+    sys_root = os.path.join(os.path.dirname(roots[0]), "sys_path")
+    _write(os.path.join(sys_root, "ayon_test_ns", "c.py"), "VALUE = 'c'")
+    install_import_finder(build_import_index(roots))
+    sys.path.append(sys_root)
+    try:
+        from ayon_test_ns import a, c
+    finally:
+        sys.path.remove(sys_root)
+
+    assert (a.VALUE, c.VALUE) == ("a", "c")
+
+    # Regular package in 'sys.path' wins over namespace portions
+    sys.modules.pop("ayon_test_ns")
+    _write(os.path.join(sys_root, "ayon_test_ns", "__init__.py"))
+    sys.path.append(sys_root)
+    try:
+        import ayon_test_ns
+    finally:
+        sys.path.remove(sys_root)
+
+    assert ayon_test_ns.__file__.startswith(sys_root)
+
+
+def test_import_index_invalidation(roots):
+    """Stored index is not used when directories changed."""
+
+    filepath = os.path.join(os.path.dirname(roots[0]), "import_index.json")
+    update_import_index(filepath, roots)
+    assert load_import_index(filepath, roots) is not None
+    assert load_import_index(filepath, list(reversed(roots))) is None
+
+    _write(os.path.join(roots[0], "ayon_test_new.py"))
+    os.utime(roots[0], ns=(0, 0))
+    assert load_import_index(filepath, roots) is None
+    assert (
+        get_import_index_filename(roots)
+        != get_import_index_filename(list(reversed(roots)))
+    )
+
+
+def test_import_finder_sys_path_priority(roots):
+    """Directories in front of index win even if they are in 'sys.path'.
+
+    Runtime directories of dependency package are in 'sys.path' and
+    had priority over addons before the finder was used.
+    """
+
+    runtime_root = os.path.join(os.path.dirname(roots[0]), "runtime")
+    _write(
+        os.path.join(runtime_root, "ayon_test_module.py"),
+        "VALUE = 'runtime'"
+    )
+    install_import_finder(build_import_index([runtime_root] + roots))
+    sys.path.insert(0, runtime_root)
+    try:
+        import ayon_test_module
+        import ayon_test_package
+    finally:
+        sys.path.remove(runtime_root)
+
+    assert ayon_test_module.VALUE == "runtime"
+    assert ayon_test_package.VALUE == "package"
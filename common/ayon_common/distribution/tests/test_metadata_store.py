@@ -0,0 +1,120 @@
+import os
+import json
+import tempfile
+import threading
+
+from common.ayon_common import metadata_store
+from common.ayon_common.metadata_store import MetadataStore
+
+
+def test_metadata_store_concurrent_updates():
+    """Concurrent read-modify-write of document does not lose updates."""
+
+    dirpath = tempfile.mkdtemp(prefix="ayon_test_")
+    store = MetadataStore(os.path.join(dirpath, "metadata.db"))
+
+    def _add(data, key):
+        data[key] = True
+
+    def _worker(idx):
+        stores = [
+            store,
+            MetadataStore(store.filepath),
+        ]
+        for item_idx in range(20):
+            stores[item_idx % 2].update_document(
+                "servers",
+                lambda data: _add(data, f"{idx}_{item_idx}"),
+                default={}
+            )
+        for item_store in stores:
+            item_store.close()
+
+    threads = [
+        threading.Thread(target=_worker, args=(idx, ))
+        for idx in range(4)
+    ]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+
+    assert len(store.get_document("servers")) == 80
+
+
+def test_metadata_store_items_mirror():
+    """Items are shared through json file and separated by root."""
+
+    dirpath = tempfile.mkdtemp(prefix="ayon_test_")
+    filepath = os.path.join(dirpath, "addons.json")
+    with open(filepath, "w") as stream:
+        json.dump({"core": {"1.0.0": {"source": "server"}}}, stream)
+
+    def _from_json(data):
+        return [
+            (name, version, version_data)
+            for name, versions in data.items()
+            for version, version_data in versions.items()
+        ]
+
+    # Stores of two machines sharing directory with items
+    stores = [
+        MetadataStore(os.path.join(dirpath, f"metadata_{idx}.db"))
+        for idx in range(2)
+    ]
+    for store in stores:
+        store.mirror_items(
+            "root_a", "addon", filepath, _from_json, lambda items: items
+        )
+
+    stores[0].set_items("root_a", "addon", [("core", "1.0.1", {})])
+    stores[0].set_items("root_b", "addon", [("core", "2.0.0", {})])
+    with open(filepath, "r") as stream:
+        assert json.load(stream) == {
+            "core": {"1.0.0": {"source": "server"}, "1.0.1": {}}
+        }
+
+    # Force different modification time on filesystems with low precision
+    os.utime(filepath, ns=(0, 0))
+    assert stores[1].get_items("root_a", "addon") == {
+        "core": {"1.0.0": {"source": "server"}, "1.0.1": {}}
+    }
+    assert stores[1].get_item("root_b", "addon", "core", "2.0.0") is None
+    assert stores[0].get_item("root_b", "addon", "core", "2.0.0") == {}
+
+
+def test_metadata_store_mirror():
+    """Document is kept in sync with json file of older versions."""
+
+    dirpath = tempfile.mkdtemp(prefix="ayon_test_")
+    store = MetadataStore(os.path.join(dirpath, "metadata.db"))
+    filepath = os.path.join(dirpath, "used_servers.json")
+    with open(filepath, "w") as stream:
+        json.dump({"last_server": "a"}, stream)
+
+    store.mirror_document("servers", filepath)
+    assert store.get_document("servers") == {"last_server": "a"}
+
+    store.update_document(
+        "servers", lambda data: data.update({"last_server": "b"})
+    )
+    with open(filepath, "r") as stream:
+        assert json.load(stream) == {"last_server": "b"}
+
+    # Older version changed the file
+    with open(filepath, "w") as stream:
+        json.dump({"last_server": "c"}, stream)
+    os.utime(filepath, ns=(0, 0))
+    assert store.get_document("servers") == {"last_server": "c"}
+
+
+def test_metadata_store_journal_fallback(monkeypatch):
+    """Rollback journal is used on network filesystems."""
+
+    dirpath = tempfile.mkdtemp(prefix="ayon_test_")
+    monkeypatch.setattr(metadata_store, "_is_network_path", lambda _: True)
+    store = MetadataStore(os.path.join(dirpath, "metadata.db"))
+    store.set_document("servers", {})
+    with store.transaction() as connection:
+        mode = connection.execute("PRAGMA journal_mode").fetchone()[0]
+    assert mode == "delete"
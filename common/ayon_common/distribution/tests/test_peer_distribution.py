@@ -0,0 +1,93 @@
+import os
+import hashlib
+import tempfile
+import threading
+
+import ayon_api
+import pytest
+
+from common.ayon_common.distribution.cache import ArtifactCache
+from common.ayon_common.distribution.peer import ArtifactPeerServer
+from common.ayon_common.distribution.downloaders import PeerDownloader
+
+PAYLOAD = os.urandom(256 * 1024)
+CHECKSUM = hashlib.sha256(PAYLOAD).hexdigest()
+
+
+@pytest.fixture
+def peers(monkeypatch):
+    """Two peers on different ports, only second has the archive."""
+
+    servers = []
+    for _ in range(2):
+        cache = ArtifactCache(
+            tempfile.mkdtemp(prefix="ayon_test_"), 1024 ** 3
+        )
+        server = ArtifactPeerServer(cache, "127.0.0.1", 0)
+        thread = threading.Thread(target=server.serve_forever, daemon=True)
+        thread.start()
+        servers.append(server)
+
+    src_path = os.path.join(tempfile.mkdtemp(prefix="ayon_test_"), "a.zip")
+    with open(src_path, "wb") as stream:
+        stream.write(PAYLOAD)
+    servers[1].artifact_cache.add(src_path, CHECKSUM, "sha256")
+
+    monkeypatch.setenv("AYON_DISTRIBUTION_PEERS", ",".join(
+        f"127.0.0.1:{server.port}"
+        for server in servers
+    ))
+    yield servers
+    for server in servers:
+        server.shutdown()
+        server.server_close()
+
+
+def test_download_from_peer(peers, monkeypatch):
+    """Archive is downloaded from peer which has it in cache."""
+
+    lookups = []
+    find_artifact = PeerDownloader._find_artifact
+
+    def _find_artifact(url):
+        lookups.append(url)
+        return find_artifact(url)
+
+    monkeypatch.setattr(PeerDownloader, "_find_artifact", _find_artifact)
+
+    dst_dir = tempfile.mkdtemp(prefix="ayon_test_")
+    source = {
+        "type": "peer",
+        "checksum": CHECKSUM,
+        "checksum_algorithm": "sha256",
+        "filename": None,
+    }
+    assert PeerDownloader.get_stream_request(source, {}) is not None
+    filepath, checksum = PeerDownloader.download_with_checksum(
+        source, dst_dir, {}, ayon_api.TransferProgress(), "sha256"
+    )
+    assert os.path.basename(filepath) == "a.zip"
+    assert checksum == CHECKSUM
+    # Peers are asked only once
+    assert len(lookups) == 2
+    with open(filepath, "rb") as stream:
+        assert stream.read() == PAYLOAD
+
+
+def test_missing_on_peers(peers):
+    """Download fails when none of peers has the archive."""
+
+    source = {
+        "type": "peer",
+        "checksum": hashlib.sha256(b"missing").hexdigest(),
+        "checksum_algorithm": "sha256",
+        "filename": None,
+    }
+    with pytest.raises(ValueError):
+        PeerDownloader.download_with_checksum(
+            source,
+            tempfile.mkdtemp(prefix="ayon_test_"),
+            {},
+            ayon_api.TransferProgress(),
+            "sha256"
+        )
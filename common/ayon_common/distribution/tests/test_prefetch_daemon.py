@@ -0,0 +1,43 @@
+from common.ayon_common.distribution import prefetch
+
+
+def test_prefetch_changed_bundles(monkeypatch):
+    """Only changed production and staging bundles are prefetched."""
+
+    bundles = [
+        {"name": "prod", "isProduction": True, "isStaging": False},
+        {"name": "staging", "isProduction": False, "isStaging": True},
+        {"name": "other", "isProduction": False, "isStaging": False},
+    ]
+    monkeypatch.setattr(
+        prefetch.ayon_api, "get_bundles", lambda: {"bundles": bundles}
+    )
+
+    prefetched = []
+    failing = {"staging"}
+
+    def _prefetch_bundle(bundle_name, bundles_info):
+        prefetched.append(bundle_name)
+        return bundle_name not in failing
+
+    daemon = prefetch.PrefetchDaemon(interval=1)
+    monkeypatch.setattr(daemon, "_prefetch_bundle", _prefetch_bundle)
+
+    assert not daemon.prefetch()
+    assert prefetched == ["prod", "staging"]
+
+    # Failed bundle is prefetched again
+    prefetched.clear()
+    failing.clear()
+    assert daemon.prefetch()
+    assert prefetched == ["prod", "staging"]
+
+    # Nothing changed on server
+    prefetched.clear()
+    assert daemon.prefetch()
+    assert prefetched == []
+
+    bundles[2]["isStaging"] = True
+    bundles[1]["isStaging"] = False
+    assert daemon.prefetch()
+    assert prefetched == ["prod", "other"]
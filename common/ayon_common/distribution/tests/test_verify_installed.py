@@ -0,0 +1,61 @@
+import os
+import tempfile
+import py_compile
+
+from common.ayon_common.distribution import verify
+from common.ayon_common.distribution.delta import (
+    create_dir_manifest,
+    write_manifest,
+)
+
+
+def test_verify_dir(monkeypatch):
+    """Only changed files are hashed and corrupted files are found."""
+
+    dirpath = tempfile.mkdtemp(prefix="ayon_test_")
+    for idx in range(4):
+        os.makedirs(os.path.join(dirpath, "addon"), exist_ok=True)
+        with open(os.path.join(dirpath, "addon", f"{idx}.py"), "wb") as f:
+            f.write(os.urandom(1024))
+    write_manifest(dirpath, create_dir_manifest(dirpath))
+
+    hashed = []
+    calculate_files_checksums = verify.calculate_files_checksums
+
+    def _calculate(filepaths, *args, **kwargs):
+        hashed.extend(filepaths)
+        return calculate_files_checksums(filepaths, *args, **kwargs)
+
+    monkeypatch.setattr(verify, "calculate_files_checksums", _calculate)
+
+    assert verify.verify_dir(dirpath) == []
+    assert len(hashed) == 4
+
+    hashed.clear()
+    assert verify.verify_dir(dirpath) == []
+    assert hashed == [], "Unchanged files were hashed again"
+
+    with open(os.path.join(dirpath, "addon", "2.py"), "r+b") as stream:
+        stream.write(b"corrupted")
+    os.remove(os.path.join(dirpath, "addon", "3.py"))
+    assert sorted(verify.verify_dir(dirpath)) == ["addon/2.py", "addon/3.py"]
+    assert len(hashed) == 1
+
+
+def test_verify_compiled_files():
+    """Compiled bytecode is verified with sources."""
+
+    dirpath = tempfile.mkdtemp(prefix="ayon_test_")
+    filepath = os.path.join(dirpath, "module.py")
+    with open(filepath, "w") as stream:
+        stream.write("VALUE = 1\n")
+    write_manifest(dirpath, create_dir_manifest(dirpath))
+    pyc_path = py_compile.compile(filepath)
+    verify.add_compiled_files_to_manifest(dirpath)
+    assert verify.verify_dir(dirpath) == []
+
+    with open(pyc_path, "r+b") as stream:
+        stream.seek(16)
+        stream.write(b"corrupted")
+    relpath = os.path.relpath(pyc_path, dirpath).replace("\\", "/")
+    assert verify.verify_dir(dirpath) == [relpath]
@@ -1,3 +1,4 @@
+import sys
 import signal
 from qtpy import QtWidgets, QtCore, QtGui
 
@@ -6,6 +7,56 @@ from ayon_common.resources import (
     load_stylesheet,
 )
 from ayon_common.ui_utils import get_qt_app
+from ayon_common.progress_channel import read_progress_channel
+
+PHASE_LABELS = {
+    "download": "Downloading",
+    "hash_check": "Validating",
+    "extract": "Extracting",
+    "compile": "Compiling",
+    "wait": "Waiting for other process",
+}
+# Window has fixed size, show only few of running items
+MAX_ITEM_LINES = 4
+
+
+def _format_size(size):
+    for unit in ("B", "KB", "MB", "GB"):
+        if size < 1024 or unit == "GB":
+            break
+        size /= 1024
+    return f"{size:.1f} {unit}"
+
+
+def _format_time(seconds):
+    seconds = int(seconds)
+    if seconds < 60:
+        return f"{seconds} s"
+    return f"{seconds // 60} min {seconds % 60} s"
+
+
+def _get_item_text(item):
+    phase = item["phase"]
+    text = PHASE_LABELS.get(phase, "Preparing")
+    done, size = item["transferred"], item["size"]
+    if phase == "extract":
+        done, size = item["unzipped"], item["unzip_size"]
+    if size:
+        text += f" {min(100, int(done * 100 / size))}%"
+    return f"{item['label']}: {text}"
+
+
+class ProgressReaderThread(QtCore.QThread):
+    """Read progress sent by distribution process to stdin."""
+
+    progress_changed = QtCore.Signal(dict)
+
+    def run(self):
+        stream = getattr(sys.stdin, "buffer", None)
+        if stream is None:
+            return
+        for progress in read_progress_channel(stream):
+            self.progress_changed.emit(progress)
 
 
 class AnimationWidget(QtWidgets.QWidget):
@@ -153,7 +204,7 @@ class AnimationWidget(QtWidgets.QWidget):
 
 class UpdateWindow(QtWidgets.QWidget):
     aspect = 10.0 / 16.0
-    default_width = 300
+    default_width = 360
 
     def __init__(self, parent=None):
         super().__init__(parent=parent)
@@ -175,12 +226,63 @@ class UpdateWindow(QtWidgets.QWidget):
         message_label = QtWidgets.QLabel("<b>AYON is updating...</b>", self)
         message_label.setAlignment(QtCore.Qt.AlignCenter)
 
+        progress_bar = QtWidgets.QProgressBar(self)
+        progress_bar.setRange(0, 1000)
+        progress_bar.setTextVisible(False)
+        progress_bar.setVisible(False)
+
+        progress_label = QtWidgets.QLabel(self)
+        progress_label.setAlignment(QtCore.Qt.AlignCenter)
+
+        items_label = QtWidgets.QLabel(self)
+        items_label.setAlignment(QtCore.Qt.AlignCenter)
+
         margin = 30
         main_layout = QtWidgets.QVBoxLayout(self)
         main_layout.setContentsMargins(margin, margin, margin, margin)
         main_layout.addWidget(anim_widget, 1)
         main_layout.addSpacing(10)
         main_layout.addWidget(message_label, 0)
+        main_layout.addWidget(progress_bar, 0)
+        main_layout.addWidget(progress_label, 0)
+        main_layout.addWidget(items_label, 0)
+
+        reader_thread = ProgressReaderThread(self)
+        reader_thread.progress_changed.connect(self._on_progress_change)
+        reader_thread.start()
+
+        self._progress_bar = progress_bar
+        self._progress_label = progress_label
+        self._items_label = items_label
+        self._reader_thread = reader_thread
+
+    def _on_progress_change(self, progress):
+        transferred = progress["transferred"]
+        size = progress["size"]
+        if size:
+            self._progress_bar.setVisible(True)
+            self._progress_bar.setValue(int(transferred * 1000 / size))
+
+        parts = [_format_size(transferred)]
+        if size:
+            parts[0] += f" / {_format_size(size)}"
+        speed = progress["speed"]
+        if speed:
+            parts.append(f"{_format_size(speed)}/s")
+        eta = progress["eta"]
+        if eta is not None and transferred != size:
+            parts.append(f"{_format_time(eta)} left")
+        self._progress_label.setText("  |  ".join(parts))
+
+        lines = [
+            _get_item_text(item)
+            for item in progress["items"]
+            if item["state"] == "running"
+        ]
+        if len(lines) > MAX_ITEM_LINES:
+            hidden = len(lines) - MAX_ITEM_LINES + 1
+            lines = lines[:MAX_ITEM_LINES - 1] + [f"and {hidden} more..."]
+        self._items_label.setText("\n".join(lines))
 
     def paintEvent(self, event):
         painter = QtGui.QPainter()
@@ -211,7 +313,13 @@ class UpdateWindow(QtWidgets.QWidget):
     def showEvent(self, event):
         super().showEvent(event)
         self.setStyleSheet(load_stylesheet())
-        self.resize(self.default_width, self.default_width * self.aspect)
+        self.resize(
+            self.default_width,
+            int(max(
+                self.default_width * self.aspect,
+                self.sizeHint().height()
+            ))
+        )
         screen_geo = self.screen().geometry()
         new_geo = self.geometry()
         offset = new_geo.center() - screen_geo.center()
@@ -1,10 +1,22 @@
 import os
 import json
+import time
+import uuid
+import shutil
+import zipfile
+import importlib.machinery
+import threading
 import subprocess
 import tempfile
 
 from ayon_common.utils import get_ayon_appdirs, get_ayon_launch_args
 
+from .progress import DistributionProgressTracker, ProgressChannelSender
+
+# Staging and download directories of interrupted distributions are removed
+#   after the time (in seconds)
+STALE_DIR_MAX_AGE = 24 * 60 * 60
+
 
 def get_local_dir(*subdirs):
     """Get product directory in user's home directory.
@@ -69,6 +81,198 @@ def get_dependencies_dir():
     return dependencies_dir
 
 
+def is_zip_import_enabled(addon_name):
+    """Addon archive is imported as zip instead of being extracted.
+
+    Addons are defined by comma separated names in 'AYON_ZIP_IMPORT_ADDONS'
+    environment variable, value '*' enables it for all addons. Only pure
+    python addons which don't access their files on disk can be imported
+    from zip. Addon directory then contains only the zip archive, addons
+    loader must use path from 'AyonDistribution.get_python_paths'.
+
+    Args:
+        addon_name (str): Name of addon.
+
+    Returns:
+        bool: Addon should be imported from zip archive.
+    """
+
+    value = os.getenv("AYON_ZIP_IMPORT_ADDONS")
+    if not value:
+        return False
+    names = {name.strip() for name in value.split(",")}
+    return "*" in names or addon_name in names
+
+
+def can_zip_import(filepath):
+    """Zip archive can be added to 'sys.path' as is.
+
+    Python 'zipimport' does not support zip64 archives, other compressions
+    than deflate and can't import binary extensions.
+
+    Args:
+        filepath (str): Path to archive.
+
+    Returns:
+        bool: Archive can be imported using 'zipimport'.
+    """
+
+    if not zipfile.is_zipfile(filepath):
+        return False
+
+    if os.path.getsize(filepath) >= zipfile.ZIP64_LIMIT:
+        return False
+
+    binary_suffixes = tuple(importlib.machinery.EXTENSION_SUFFIXES) + (
+        ".pyd", ".so", ".dll", ".dylib"
+    )
+    with zipfile.ZipFile(filepath) as zip_file:
+        members = zip_file.infolist()
+        if len(members) >= zipfile.ZIP_FILECOUNT_LIMIT:
+            return False
+
+        for member in members:
+            if member.compress_type not in (
+                zipfile.ZIP_STORED, zipfile.ZIP_DEFLATED
+            ):
+                return False
+            # Encrypted member
+            if member.flag_bits & 0x1:
+                return False
+            if member.filename.lower().endswith(binary_suffixes):
+                return False
+    return True
+
+
+def get_sibling_dirpath(dirpath, suffix, unique=False):
+    """Path to hidden directory next to a directory.
+
+    Used for staging, download and to be removed directories of installed
+    addons and dependency packages.
+
+    Args:
+        dirpath (str): Path to directory.
+        suffix (str): Suffix of sibling directory, e.g. 'staging'.
+        unique (Optional[bool]): Add unique identifier to the name.
+
+    Returns:
+        str: Path to sibling directory.
+    """
+
+    dirpath = os.path.normpath(dirpath)
+    name = os.path.basename(dirpath)
+    if unique:
+        name = f"{name}.{uuid.uuid4().hex}"
+    return os.path.join(os.path.dirname(dirpath), f".{name}.{suffix}")
+
+
+def _remove_dirs(dirpaths):
+    for dirpath in dirpaths:
+        shutil.rmtree(dirpath, ignore_errors=True)
+
+
+def remove_dir_in_background(*dirpaths):
+    """Remove directories in a daemon thread.
+
+    Directory may stay partially removed if process ends sooner, it is
+    removed by 'cleanup_stale_dirs' on next start.
+
+    Args:
+        *dirpaths (str): Paths to directories.
+
+    Returns:
+        threading.Thread: Thread removing the directories.
+    """
+
+    thread = threading.Thread(
+        target=_remove_dirs,
+        args=(dirpaths, ),
+        name="ayon_remove_dir",
+        daemon=True,
+    )
+    thread.start()
+    return thread
+
+
+def replace_dir(src_dirpath, dst_dirpath):
+    """Replace directory with other directory using renames.
+
+    Existing destination directory is renamed to sibling 'trash' directory,
+    so it can be removed later. Original destination is restored if
+    source can't be renamed.
+
+    Args:
+        src_dirpath (str): Directory which replaces destination.
+        dst_dirpath (str): Directory which is replaced.
+
+    Returns:
+        Union[str, None]: Path to renamed original destination directory
+            which should be removed.
+    """
+
+    trash_dirpath = None
+    if os.path.exists(dst_dirpath):
+        trash_dirpath = get_sibling_dirpath(dst_dirpath, "trash", True)
+        os.rename(dst_dirpath, trash_dirpath)
+
+    try:
+        os.rename(src_dirpath, dst_dirpath)
+    except Exception:
+        if trash_dirpath is not None:
+            os.rename(trash_dirpath, dst_dirpath)
+        raise
+    return trash_dirpath
+
+
+def cleanup_stale_dirs(dirpath, max_age=STALE_DIR_MAX_AGE):
+    """Remove leftovers of interrupted distributions in background.
+
+    Replaced directories are removed always, staging and download
+    directories only if they were not modified for 'max_age', so
+    distribution running in other process is not affected and
+    interrupted downloads can be resumed. Stale directories are renamed
+    before the function returns, so they can't be used by distribution
+    which starts right after.
+
+    Args:
+        dirpath (str): Directory with installed addons or dependency
+            packages.
+        max_age (Optional[float]): Age in seconds after which are staging
+            and download directories removed.
+
+    Returns:
+        Union[threading.Thread, None]: Thread removing the directories.
+    """
+
+    if not os.path.isdir(dirpath):
+        return None
+
+    now = time.time()
+    trash_dirpaths = []
+    for name in os.listdir(dirpath):
+        if not name.startswith("."):
+            continue
+        path = os.path.join(dirpath, name)
+        if name.endswith(".trash"):
+            trash_dirpaths.append(path)
+            continue
+
+        if not name.endswith((".staging", ".download")):
+            continue
+        try:
+            if now - os.path.getmtime(path) < max_age:
+                continue
+            trash_dirpath = f"{path}.trash"
+            os.rename(path, trash_dirpath)
+        except OSError:
+            continue
+        trash_dirpaths.append(trash_dirpath)
+
+    if not trash_dirpaths:
+        return None
+    return remove_dir_in_background(*trash_dirpaths)
+
+
 def show_missing_bundle_information(url, bundle_name=None):
     """Show missing bundle information window.
 
@@ -123,8 +327,17 @@ def show_installer_issue_information(message, installer_path=None):
 
 
 class UpdateWindowManager:
+    """Show update window in subprocess while distribution is running.
+
+    Progress of distribution is sent to the window through stdin of the
+    process. Register 'on_distribution_event' as event callback of
+    distribution to show the progress.
+    """
+
     def __init__(self):
         self._process = None
+        self._tracker = DistributionProgressTracker()
+        self._sender = None
 
     def __enter__(self):
         self.start()
@@ -138,11 +351,31 @@ class UpdateWindowManager:
         script_path = os.path.join(ui_dir, "update_window.py")
 
         args = get_ayon_launch_args(script_path, "--skip-bootstrap")
-        self._process = subprocess.Popen(args)
+        self._process = subprocess.Popen(args, stdin=subprocess.PIPE)
+        self._sender = ProgressChannelSender(
+            self._tracker, self._process.stdin
+        )
+        self._sender.start()
+
+    def on_distribution_event(self, event):
+        """Callback for distribution events.
+
+        Args:
+            event (DistributionEvent): Distribution event.
+        """
+
+        self._tracker.process_event(event)
 
     def stop(self):
         if self._process is None:
             return
+        if self._sender is not None:
+            self._sender.stop()
+            self._sender = None
         if self._process.poll() is None:
             self._process.kill()
+        try:
+            self._process.stdin.close()
+        except OSError:
+            pass
         self._process = None
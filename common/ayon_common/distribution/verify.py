@@ -0,0 +1,215 @@
+"""Verification of content of distributed items.
+
+Distributed item is marked as distributed in metadata store, content
+of its directory is not checked on boot. Files can be corrupted on
+shared or network storages.
+
+Content is verified against manifest of the item, with size and CRC32
+of each file. Verified files are stored to fingerprint cache with their
+size, modification time and inode, so only files which changed since
+last verification are read and hashed again. Verification of unchanged
+directory costs only stat of each file.
+
+Bytecode compiled on distribution is not validated against sources on
+import, so compiled files are added to the manifest as well.
+
+Verification is enabled with '--verify-installed' argument or by setting
+'AYON_VERIFY_INSTALLED' environment variable to '1'.
+"""
+
+import os
+import json
+import uuid
+
+from ayon_common.checksum import calculate_files_checksums
+
+from .delta import read_manifest, write_manifest
+
+VERIFY_CACHE_FILENAME = ".ayon_verified.json"
+VERIFY_CACHE_VERSION = 1
+
+
+def is_verify_installed_enabled():
+    """Content of distributed items is verified on boot.
+
+    Returns:
+        bool: Verification is enabled.
+    """
+
+    return os.getenv("AYON_VERIFY_INSTALLED") == "1"
+
+
+def _get_fingerprint(filepath, crc32):
+    stat = os.stat(filepath)
+    return [stat.st_size, stat.st_mtime_ns, stat.st_ino, crc32]
+
+
+def load_verify_cache(dirpath):
+    """Fingerprints of verified files in directory.
+
+    Args:
+        dirpath (str): Directory of distributed item.
+
+    Returns:
+        dict[str, list[int]]: Size, modification time, inode and CRC32
+            of verified files by their relative path.
+    """
+
+    filepath = os.path.join(dirpath, VERIFY_CACHE_FILENAME)
+    try:
+        with open(filepath, "r") as stream:
+            data = json.load(stream)
+    except (OSError, ValueError):
+        return {}
+    if data.get("version") != VERIFY_CACHE_VERSION:
+        return {}
+    return data.get("files") or {}
+
+
+def save_verify_cache(dirpath, files):
+    """Store fingerprints of verified files.
+
+    Args:
+        dirpath (str): Directory of distributed item.
+        files (dict[str, list[int]]): Fingerprints by relative path.
+    """
+
+    filepath = os.path.join(dirpath, VERIFY_CACHE_FILENAME)
+    # Other processes may verify the same directory
+    tmp_path = f"{filepath}.{uuid.uuid4().hex}.tmp"
+    try:
+        with open(tmp_path, "w") as stream:
+            json.dump(
+                {"version": VERIFY_CACHE_VERSION, "files": files}, stream
+            )
+        os.replace(tmp_path, filepath)
+    finally:
+        if os.path.exists(tmp_path):
+            os.remove(tmp_path)
+
+
+def add_compiled_files_to_manifest(dirpath):
+    """Add compiled bytecode files to manifest of directory.
+
+    Should be called right after sources in directory were compiled.
+
+    Args:
+        dirpath (str): Directory with content and manifest.
+    """
+
+    manifest = read_manifest(dirpath)
+    if manifest is None:
+        return
+
+    filepaths = []
+    for root, dirnames, filenames in os.walk(dirpath):
+        if os.path.basename(root) != "__pycache__":
+            continue
+        filepaths.extend(
+            os.path.join(root, filename)
+            for filename in filenames
+            if filename.endswith(".pyc")
+        )
+
+    if not filepaths:
+        return
+
+    checksums = calculate_files_checksums(filepaths, "crc32")
+    files = manifest["files"]
+    for filepath in filepaths:
+        relpath = os.path.relpath(filepath, dirpath).replace("\\", "/")
+        files[relpath] = {
+            "size": os.path.getsize(filepath),
+            "crc32": int(checksums[filepath], 16),
+        }
+    write_manifest(dirpath, manifest)
+
+
+def update_verify_cache(dirpath):
+    """Store fingerprints of all files in manifest without hashing.
+
+    Should be called only right after content was extracted and validated.
+
+    Args:
+        dirpath (str): Directory of distributed item.
+    """
+
+    manifest = read_manifest(dirpath)
+    if manifest is None:
+        return
+
+    files = {}
+    for relpath, info in manifest["files"].items():
+        try:
+            files[relpath] = _get_fingerprint(
+                os.path.join(dirpath, relpath), info["crc32"]
+            )
+        except OSError:
+            continue
+    save_verify_cache(dirpath, files)
+
+
+def verify_dir(dirpath, max_workers=None):
+    """Verify content of directory against its manifest.
+
+    Only files which changed since last verification are hashed.
+
+    Args:
+        dirpath (str): Directory of distributed item.
+        max_workers (Optional[int]): Maximum number of files hashed
+            at the same time.
+
+    Returns:
+        Union[list[str], None]: Relative paths of missing or corrupted
+            files, or None if directory does not have manifest.
+    """
+
+    manifest = read_manifest(dirpath)
+    if manifest is None:
+        return None
+
+    cache = load_verify_cache(dirpath)
+    verified = {}
+    invalid = []
+    to_hash = []
+    for relpath, info in manifest["files"].items():
+        filepath = os.path.join(dirpath, relpath)
+        try:
+            fingerprint = _get_fingerprint(filepath, info["crc32"])
+        except OSError:
+            invalid.append(relpath)
+            continue
+
+        if fingerprint[0] != info["size"]:
+            invalid.append(relpath)
+        elif cache.get(relpath) == fingerprint:
+            verified[relpath] = fingerprint
+        else:
+            to_hash.append((relpath, filepath, fingerprint))
+
+    checksums = {}
+    if to_hash:
+        try:
+            checksums = calculate_files_checksums(
+                [filepath for _, filepath, _ in to_hash],
+                "crc32",
+                max_workers
+            )
+        except ValueError:
+            # File was removed during verification
+            pass
+
+    for relpath, filepath, fingerprint in to_hash:
+        checksum = checksums.get(filepath)
+        if checksum is not None and int(checksum, 16) == fingerprint[3]:
+            verified[relpath] = fingerprint
+        else:
+            invalid.append(relpath)
+
+    if verified != cache:
+        try:
+            save_verify_cache(dirpath, verified)
+        except OSError:
+            # Directory can be read-only for current user
+            pass
+    return invalid
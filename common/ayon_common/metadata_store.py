@@ -0,0 +1,590 @@
+"""Local store of AYON launcher metadata.
+
+Metadata about distributed addons and dependency packages, available
+executables and used servers are stored in single SQLite database in
+AYON appdirs. Database uses WAL journal, so readers don't block writer,
+and changes are done in transactions, so multiple launcher processes
+running at the same time don't overwrite changes of each other.
+
+WAL journal requires shared memory which does not work on network
+filesystems. Rollback journal is used if AYON appdirs are on network
+filesystem or if switch to WAL journal failed.
+
+Metadata were previously stored in json files which are still read by
+older versions of AYON launcher, so they're mirrored. Data are written
+to the json file on each change and imported again when the json file
+was changed by other process.
+
+Database is local to the machine and user. SQLite databases must not be
+stored on network storages, so metadata of distributed items are keyed
+by directory where they were distributed. Json files of distributed
+items are stored next to the items, so machines sharing the directory
+know about items distributed by each other.
+"""
+
+import os
+import json
+import uuid
+import sqlite3
+import platform
+import threading
+import contextlib
+
+from .utils import get_ayon_appdirs
+
+SCHEMA_VERSION = 2
+# Seconds to wait for lock of other process
+BUSY_TIMEOUT = 30
+
+_SCHEMA = (
+    """
+    CREATE TABLE IF NOT EXISTS documents (
+        name TEXT PRIMARY KEY,
+        data TEXT NOT NULL
+    )
+    """,
+    """
+    CREATE TABLE IF NOT EXISTS distributed_items (
+        root TEXT NOT NULL,
+        kind TEXT NOT NULL,
+        name TEXT NOT NULL,
+        version TEXT NOT NULL,
+        data TEXT NOT NULL,
+        PRIMARY KEY (root, kind, name, version)
+    )
+    """,
+    """
+    CREATE TABLE IF NOT EXISTS mirrors (
+        source TEXT PRIMARY KEY,
+        mtime INTEGER NOT NULL
+    )
+    """,
+)
+# Filesystem types where WAL journal can't be used
+_NETWORK_FILESYSTEMS = {
+    "nfs",
+    "nfs4",
+    "cifs",
+    "smbfs",
+    "smb3",
+    "afs",
+    "ncpfs",
+    "9p",
+    "fuse.sshfs",
+}
+# Value of 'GetDriveTypeW' for network drives
+_DRIVE_REMOTE = 4
+
+
+def get_metadata_store_filepath():
+    """Path to metadata database.
+
+    Returns:
+        str: Path to database file.
+    """
+
+    return get_ayon_appdirs("metadata.db")
+
+
+def _read_json_file(filepath):
+    try:
+        with open(filepath, "r") as stream:
+            return json.load(stream)
+    except (OSError, ValueError):
+        return None
+
+
+def _write_json_file(filepath, data):
+    dirpath = os.path.dirname(filepath)
+    if dirpath:
+        os.makedirs(dirpath, exist_ok=True)
+    tmp_path = f"{filepath}.{uuid.uuid4().hex}.tmp"
+    try:
+        with open(tmp_path, "w") as stream:
+            json.dump(data, stream, indent=4)
+        os.replace(tmp_path, filepath)
+    finally:
+        if os.path.exists(tmp_path):
+            os.remove(tmp_path)
+
+
+def _get_file_mtime(filepath):
+    try:
+        return os.stat(filepath).st_mtime_ns
+    except OSError:
+        return None
+
+
+def _is_network_path(path):
+    """Path is on network filesystem.
+
+    Args:
+        path (str): Path to check.
+
+    Returns:
+        bool: Path is on network filesystem. False if it can't be
+            detected.
+    """
+
+    path = os.path.abspath(path)
+    try:
+        if platform.system().lower() == "windows":
+            import ctypes
+
+            if path.startswith("\\\\"):
+                return True
+            drive = os.path.splitdrive(path)[0] + "\\"
+            return (
+                ctypes.windll.kernel32.GetDriveTypeW(drive) == _DRIVE_REMOTE
+            )
+
+        # Filesystem of the longest mount point containing the path
+        fs_type = None
+        mount_len = -1
+        with open("/proc/mounts", "r") as stream:
+            for line in stream:
+                parts = line.split()
+                if len(parts) < 3:
+                    continue
+                mount_point = parts[1].replace("\\040", " ")
+                if (
+                    len(mount_point) > mount_len
+                    and (
+                        path == mount_point
+                        or path.startswith(mount_point.rstrip("/") + "/")
+                    )
+                ):
+                    mount_len = len(mount_point)
+                    fs_type = parts[2]
+    except Exception:
+        return False
+    return fs_type in _NETWORK_FILESYSTEMS
+
+
+class MetadataStore:
+    """Transactional store of metadata in SQLite database.
+
+    Each thread uses own connection to the database.
+
+    Args:
+        filepath (Optional[str]): Path to database file. Default path in
+            AYON appdirs is used if not passed.
+    """
+
+    def __init__(self, filepath=None):
+        if filepath is None:
+            filepath = get_metadata_store_filepath()
+        self._filepath = filepath
+        self._local = threading.local()
+        self._init_lock = threading.Lock()
+        self._initialized = False
+        self._use_wal = None
+        # Json files mirroring documents by document name
+        self._mirrors = {}
+        # Json files mirroring items with conversion functions by root
+        #   and kind of items
+        self._item_mirrors = {}
+
+    @property
+    def filepath(self):
+        return self._filepath
+
+    def _get_connection(self):
+        connection = getattr(self._local, "connection", None)
+        if connection is not None:
+            return connection
+
+        dirpath = os.path.dirname(self._filepath)
+        if dirpath:
+            os.makedirs(dirpath, exist_ok=True)
+        # Transactions are handled explicitly
+        connection = sqlite3.connect(
+            self._filepath, timeout=BUSY_TIMEOUT, isolation_level=None
+        )
+        self._set_journal_mode(connection)
+        connection.execute("PRAGMA synchronous=NORMAL")
+        self._local.connection = connection
+
+        with self._init_lock:
+            if not self._initialized:
+                self._create_schema(connection)
+                self._initialized = True
+        return connection
+
+    def _set_journal_mode(self, connection):
+        if self._use_wal is None:
+            self._use_wal = not _is_network_path(
+                os.path.dirname(os.path.abspath(self._filepath))
+            )
+
+        if self._use_wal:
+            mode = connection.execute("PRAGMA journal_mode=WAL").fetchone()
+            if mode and mode[0].lower() == "wal":
+                return
+            # Filesystem does not support WAL journal
+            self._use_wal = False
+        connection.execute("PRAGMA journal_mode=DELETE")
+
+    def _create_schema(self, connection):
+        version = connection.execute("PRAGMA user_version").fetchone()[0]
+        if version == SCHEMA_VERSION:
+            return
+        with self._transaction(connection):
+            for statement in _SCHEMA:
+                connection.execute(statement)
+            connection.execute(f"PRAGMA user_version={SCHEMA_VERSION}")
+
+    @contextlib.contextmanager
+    def _transaction(self, connection):
+        # Write lock is acquired at start, so read-modify-write of other
+        #   process can't interleave
+        connection.execute("BEGIN IMMEDIATE")
+        try:
+            yield connection
+        except BaseException:
+            connection.execute("ROLLBACK")
+            raise
+        connection.execute("COMMIT")
+
+    @contextlib.contextmanager
+    def transaction(self):
+        """Atomic transaction holding write lock of database.
+
+        Yields:
+            sqlite3.Connection: Connection in transaction.
+        """
+
+        with self._transaction(self._get_connection()) as connection:
+            yield connection
+
+    def close(self):
+        """Close connection of current thread."""
+
+        connection = getattr(self._local, "connection", None)
+        if connection is not None:
+            connection.close()
+            self._local.connection = None
+
+    # Documents
+    def _get_document(self, connection, name, default):
+        row = connection.execute(
+            "SELECT data FROM documents WHERE name = ?", (name, )
+        ).fetchone()
+        if row is None:
+            return default
+        return json.loads(row[0])
+
+    def _set_document_row(self, connection, name, data):
+        connection.execute(
+            "INSERT OR REPLACE INTO documents (name, data) VALUES (?, ?)",
+            (name, json.dumps(data))
+        )
+
+    def _set_document(self, connection, name, data):
+        self._set_document_row(connection, name, data)
+        filepath = self._mirrors.get(name)
+        if filepath is None:
+            return
+        try:
+            _write_json_file(filepath, data)
+        except OSError:
+            # Database is the source of truth
+            return
+        self._set_mirror_mtime(connection, filepath)
+
+    # Json files mirroring documents
+    def _get_mirror_mtime(self, connection, filepath):
+        row = connection.execute(
+            "SELECT mtime FROM mirrors WHERE source = ?", (filepath, )
+        ).fetchone()
+        if row is None:
+            return None
+        return row[0]
+
+    def _set_mirror_mtime(self, connection, filepath):
+        mtime = _get_file_mtime(filepath)
+        if mtime is not None:
+            connection.execute(
+                "INSERT OR REPLACE INTO mirrors (source, mtime)"
+                " VALUES (?, ?)",
+                (filepath, mtime)
+            )
+
+    def _sync_mirror(self, connection, name):
+        """Import json file mirroring document if it changed.
+
+        Must be called in transaction.
+        """
+
+        filepath = self._mirrors.get(name)
+        if filepath is None:
+            return
+        mtime = _get_file_mtime(filepath)
+        stored_mtime = self._get_mirror_mtime(connection, filepath)
+        if mtime is None or mtime == stored_mtime:
+            return
+
+        current = self._get_document(connection, name, None)
+        data = _read_json_file(filepath)
+        if stored_mtime is None and current is not None:
+            # File was imported before it was mirrored, content in
+            #   database is newer
+            self._set_document(connection, name, current)
+            return
+
+        if data is not None:
+            self._set_document_row(connection, name, data)
+        self._set_mirror_mtime(connection, filepath)
+
+    def _is_file_changed(self, connection, filepath):
+        mtime = _get_file_mtime(filepath)
+        return (
+            mtime is not None
+            and mtime != self._get_mirror_mtime(connection, filepath)
+        )
+
+    def mirror_document(self, name, filepath):
+        """Keep document in sync with json file.
+
+        Json file is imported if it changed since it was last written by
+        the store, and document is written to the file on each change.
+
+        Args:
+            name (str): Name of document.
+            filepath (str): Path to json file.
+        """
+
+        self._mirrors[name] = filepath
+        connection = self._get_connection()
+        if not self._is_file_changed(connection, filepath):
+            return
+        with self._transaction(connection):
+            self._sync_mirror(connection, name)
+
+    def get_document(self, name, default=None):
+        """Get stored document.
+
+        Args:
+            name (str): Name of document.
+            default (Optional[Any]): Value returned if document is
+                not stored.
+
+        Returns:
+            Any: Document data.
+        """
+
+        connection = self._get_connection()
+        filepath = self._mirrors.get(name)
+        if filepath and self._is_file_changed(connection, filepath):
+            with self._transaction(connection):
+                self._sync_mirror(connection, name)
+        return self._get_document(connection, name, default)
+
+    def set_document(self, name, data):
+        """Store document.
+
+        Args:
+            name (str): Name of document.
+            data (Any): Json serializable data.
+        """
+
+        with self.transaction() as connection:
+            self._set_document(connection, name, data)
+
+    def update_document(self, name, callback, default=None):
+        """Atomic read-modify-write of document.
+
+        Args:
+            name (str): Name of document.
+            callback (Callable[[Any], Any]): Receives current data and
+                returns new data. Data can be also modified in place
+                and callback returns None.
+            default (Optional[Any]): Data passed to callback if document
+                is not stored.
+
+        Returns:
+            Any: New data of document.
+        """
+
+        with self.transaction() as connection:
+            self._sync_mirror(connection, name)
+            data = self._get_document(connection, name, default)
+            new_data = callback(data)
+            if new_data is None:
+                new_data = data
+            self._set_document(connection, name, new_data)
+        return new_data
+
+    # Distributed items
+    def get_items(self, root, kind, name=None):
+        """Metadata of distributed items.
+
+        Args:
+            root (str): Directory where items are distributed.
+            kind (str): Kind of items, e.g. 'addon'.
+            name (Optional[str]): Return only versions of item with name.
+
+        Returns:
+            dict[str, dict[str, Any]]: Data by item name and version.
+        """
+
+        self._sync_items_mirror_if_changed(root, kind)
+        return self._get_items(self._get_connection(), root, kind, name)
+
+    def _get_items(self, connection, root, kind, name=None):
+        query = (
+            "SELECT name, version, data FROM distributed_items"
+            " WHERE root = ? AND kind = ?"
+        )
+        args = [root, kind]
+        if name is not None:
+            query += " AND name = ?"
+            args.append(name)
+
+        output = {}
+        for item_name, version, data in connection.execute(query, args):
+            output.setdefault(item_name, {})[version] = json.loads(data)
+        return output
+
+    def get_item(self, root, kind, name, version):
+        """Metadata of distributed item.
+
+        Args:
+            root (str): Directory where item is distributed.
+            kind (str): Kind of item, e.g. 'addon'.
+            name (str): Name of item.
+            version (str): Version of item.
+
+        Returns:
+            Union[dict[str, Any], None]: Item data.
+        """
+
+        self._sync_items_mirror_if_changed(root, kind)
+        row = self._get_connection().execute(
+            "SELECT data FROM distributed_items"
+            " WHERE root = ? AND kind = ? AND name = ? AND version = ?",
+            (root, kind, name, version)
+        ).fetchone()
+        if row is None:
+            return None
+        return json.loads(row[0])
+
+    def _set_items(self, connection, root, kind, items, replace=True):
+        conflict = "REPLACE" if replace else "IGNORE"
+        connection.executemany(
+            f"INSERT OR {conflict} INTO distributed_items"
+            " (root, kind, name, version, data) VALUES (?, ?, ?, ?, ?)",
+            [
+                (root, kind, name, version, json.dumps(data))
+                for name, version, data in items
+            ]
+        )
+
+    def set_items(self, root, kind, items):
+        """Store metadata of distributed items in single transaction.
+
+        Args:
+            root (str): Directory where items are distributed.
+            kind (str): Kind of items, e.g. 'addon'.
+            items (Iterable[tuple[str, str, dict[str, Any]]]): Name,
+                version and data of items.
+        """
+
+        with self.transaction() as connection:
+            mirrored = (root, kind) in self._item_mirrors
+            if mirrored:
+                self._sync_items_mirror(connection, root, kind)
+            self._set_items(connection, root, kind, items)
+            if mirrored:
+                self._write_items_mirror(connection, root, kind)
+
+    # Json files mirroring distributed items
+    def _write_items_mirror(self, connection, root, kind):
+        filepath, _, to_json = self._item_mirrors[(root, kind)]
+        items = self._get_items(connection, root, kind)
+        try:
+            _write_json_file(filepath, to_json(items))
+        except OSError:
+            # Directory can be read-only for current user
+            return
+        self._set_mirror_mtime(connection, filepath)
+
+    def _sync_items_mirror(self, connection, root, kind):
+        """Import json file mirroring items if it changed.
+
+        Items from the file are merged to items in database, items are
+        never removed. Must be called in transaction.
+        """
+
+        mirror = self._item_mirrors.get((root, kind))
+        if mirror is None:
+            return
+        filepath, from_json, _ = mirror
+        mtime = _get_file_mtime(filepath)
+        stored_mtime = self._get_mirror_mtime(connection, filepath)
+        if mtime is None or mtime == stored_mtime:
+            return
+
+        data = _read_json_file(filepath)
+        if data:
+            # Items in database may be newer than content of file which
+            #   was not mirrored yet
+            self._set_items(
+                connection,
+                root,
+                kind,
+                from_json(data),
+                replace=stored_mtime is not None
+            )
+        if stored_mtime is None:
+            self._write_items_mirror(connection, root, kind)
+        else:
+            self._set_mirror_mtime(connection, filepath)
+
+    def _sync_items_mirror_if_changed(self, root, kind):
+        mirror = self._item_mirrors.get((root, kind))
+        if mirror is None:
+            return
+        connection = self._get_connection()
+        if self._is_file_changed(connection, mirror[0]):
+            with self._transaction(connection):
+                self._sync_items_mirror(connection, root, kind)
+
+    def mirror_items(self, root, kind, filepath, from_json, to_json):
+        """Keep items in sync with json file next to them.
+
+        Directory with items can be shared by multiple machines and
+        older versions of AYON launcher, which know about items only
+        from the json file. Json file is imported if it changed since it
+        was last written by the store, and all items are written to the
+        file on each change.
+
+        Args:
+            root (str): Directory where items are distributed.
+            kind (str): Kind of items, e.g. 'addon'.
+            filepath (str): Path to json file.
+            from_json (Callable[[Any], Iterable[tuple[str, str, dict]]]):
+                Convert content of json file to items.
+            to_json (Callable[[dict[str, dict[str, Any]]], Any]): Convert
+                items by name and version to content of json file.
+        """
+
+        self._item_mirrors[(root, kind)] = (filepath, from_json, to_json)
+        self._sync_items_mirror_if_changed(root, kind)
+
+_STORE = None
+_STORE_LOCK = threading.Lock()
+
+
+def get_metadata_store():
+    """Metadata store in AYON appdirs shared in process.
+
+    Returns:
+        MetadataStore: Metadata store.
+    """
+
+    global _STORE
+    with _STORE_LOCK:
+        if _STORE is None:
+            _STORE = MetadataStore()
+    return _STORE
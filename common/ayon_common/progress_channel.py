@@ -0,0 +1,40 @@
+"""Channel of distribution progress between processes.
+
+Progress is sent as json lines through stdin of update window process.
+The module does not import anything from distribution, so update window
+process can read progress without loading the distribution.
+"""
+
+import json
+
+
+def write_progress(stream, progress):
+    """Send progress snapshot to stream.
+
+    Args:
+        stream (BinaryIO): Writable stream, e.g. stdin of process.
+        progress (dict[str, Any]): Progress snapshot.
+    """
+
+    stream.write(json.dumps(progress).encode() + b"\n")
+    stream.flush()
+
+
+def read_progress_channel(stream):
+    """Read progress sent by 'write_progress'.
+
+    Args:
+        stream (BinaryIO): Readable stream, e.g. stdin.
+
+    Yields:
+        dict[str, Any]: Progress snapshot.
+    """
+
+    for line in stream:
+        line = line.strip()
+        if not line:
+            continue
+        try:
+            yield json.loads(line)
+        except ValueError:
+            continue
@@ -0,0 +1,264 @@
+"""Timing of bootstrap phases.
+
+Tracer records nested spans of bootstrap phases and stores them as
+Chrome trace JSON which can be opened in 'chrome://tracing' or
+'https://ui.perfetto.dev'. Nesting of spans is defined by their time
+range per thread, so spans of distribution items processed in worker
+threads are shown in own tracks.
+
+Tracing is enabled with '--trace-boot' argument or by setting
+'AYON_BOOT_TRACE' environment variable to '1'. Trace is stored to
+'logs' directory in AYON appdirs unless 'AYON_BOOT_TRACE_PATH' defines
+output filepath.
+"""
+
+import os
+import sys
+import json
+import time
+import threading
+import contextlib
+
+from .utils import get_ayon_appdirs
+
+
+def is_boot_trace_enabled():
+    """Tracing of bootstrap phases is enabled.
+
+    Returns:
+        bool: Tracing is enabled.
+    """
+
+    return os.getenv("AYON_BOOT_TRACE") == "1"
+
+
+class BootTracer:
+    """Collect spans of bootstrap phases.
+
+    Spans are stored as complete events ('X') of Chrome trace format with
+    timestamps in microseconds of 'time.perf_counter', so spans measured
+    before tracer was created can be added too. All methods are thread
+    safe and do nothing when tracer is disabled.
+
+    Args:
+        enabled (Optional[bool]): Record spans. Value of
+            'is_boot_trace_enabled' is used if not passed.
+    """
+
+    def __init__(self, enabled=None):
+        if enabled is None:
+            enabled = is_boot_trace_enabled()
+        self._enabled = enabled
+        self._pid = os.getpid()
+        self._lock = threading.Lock()
+        self._events = []
+        self._thread_names = {}
+        self._filepath = None
+
+    @property
+    def enabled(self):
+        return self._enabled
+
+    @property
+    def filepath(self):
+        """Path where trace was stored by last 'save'.
+
+        Returns:
+            Union[str, None]: Path to trace file.
+        """
+
+        return self._filepath
+
+    def _to_us(self, value):
+        return int(value * 1000000)
+
+    def _get_tid(self):
+        thread = threading.current_thread()
+        tid = thread.ident
+        if tid not in self._thread_names:
+            self._thread_names[tid] = thread.name
+        return tid
+
+    def add_span(self, name, start, end, **args):
+        """Add span with known start and end.
+
+        Args:
+            name (str): Name of span.
+            start (float): Start time from 'time.perf_counter'.
+            end (float): End time from 'time.perf_counter'.
+            **args (Any): Additional information shown with span.
+        """
+
+        if not self._enabled:
+            return
+
+        event = {
+            "name": name,
+            "ph": "X",
+            "ts": self._to_us(start),
+            "dur": max(0, int((end - start) * 1000000)),
+            "pid": self._pid,
+            "tid": None,
+        }
+        if args:
+            event["args"] = {
+                key: str(value)
+                for key, value in args.items()
+            }
+        with self._lock:
+            event["tid"] = self._get_tid()
+            self._events.append(event)
+
+    @contextlib.contextmanager
+    def span(self, name, **args):
+        """Record duration of code block.
+
+        Exception raised inside of the block is stored to span arguments
+        and re-raised.
+
+        Args:
+            name (str): Name of span.
+            **args (Any): Additional information shown with span.
+        """
+
+        if not self._enabled:
+            yield
+            return
+
+        start = time.perf_counter()
+        try:
+            yield
+        except BaseException as exc:
+            args["error"] = exc.__class__.__name__
+            raise
+        finally:
+            self.add_span(name, start, time.perf_counter(), **args)
+
+    def mark(self, name, **args):
+        """Record instant event.
+
+        Args:
+            name (str): Name of event.
+            **args (Any): Additional information shown with event.
+        """
+
+        if not self._enabled:
+            return
+
+        event = {
+            "name": name,
+            "ph": "i",
+            "s": "p",
+            "ts": self._to_us(time.perf_counter()),
+            "pid": self._pid,
+        }
+        if args:
+            event["args"] = {
+                key: str(value)
+                for key, value in args.items()
+            }
+        with self._lock:
+            event["tid"] = self._get_tid()
+            self._events.append(event)
+
+    def get_trace_data(self):
+        """Recorded spans in Chrome trace format.
+
+        Returns:
+            dict[str, Any]: Trace data.
+        """
+
+        with self._lock:
+            events = list(self._events)
+            thread_names = dict(self._thread_names)
+
+        metadata = [
+            {
+                "name": "process_name",
+                "ph": "M",
+                "pid": self._pid,
+                "args": {"name": "AYON launcher"},
+            }
+        ]
+        for tid, thread_name in thread_names.items():
+            metadata.append({
+                "name": "thread_name",
+                "ph": "M",
+                "pid": self._pid,
+                "tid": tid,
+                "args": {"name": thread_name},
+            })
+        return {
+            "traceEvents": metadata + events,
+            "displayTimeUnit": "ms",
+            "otherData": {
+                "version": os.getenv("AYON_VERSION") or "",
+                "argv": " ".join(sys.argv),
+            },
+        }
+
+    def get_default_filepath(self):
+        filepath = os.getenv("AYON_BOOT_TRACE_PATH")
+        if filepath:
+            return filepath
+        timestamp = time.strftime("%Y%m%d_%H%M%S")
+        return get_ayon_appdirs(
+            "logs", f"boot_trace_{timestamp}_{self._pid}.json"
+        )
+
+    def save(self, filepath=None):
+        """Store recorded spans to a json file.
+
+        Trace is stored to the same file on repeated calls, so trace
+        can be stored before long running process starts and updated
+        when it ends.
+
+        Args:
+            filepath (Optional[str]): Output filepath. Filepath of previous
+                save or default filepath in AYON appdirs logs is used
+                if not passed.
+
+        Returns:
+            Union[str, None]: Path to stored trace or None if tracer
+                is disabled.
+        """
+
+        if not self._enabled:
+            return None
+
+        if filepath is None:
+            filepath = self._filepath or self.get_default_filepath()
+        dirpath = os.path.dirname(filepath)
+        if dirpath:
+            os.makedirs(dirpath, exist_ok=True)
+        with open(filepath, "w") as stream:
+            json.dump(self.get_trace_data(), stream)
+        self._filepath = filepath
+        return filepath
+
+
+_TRACER = None
+
+
+def get_boot_tracer():
+    """Tracer shared by bootstrap logic.
+
+    Returns:
+        BootTracer: Tracer object.
+    """
+
+    global _TRACER
+    if _TRACER is None:
+        _TRACER = BootTracer()
+    return _TRACER
+
+
+def trace_span(name, **args):
+    """Record duration of code block using shared tracer.
+
+    Args:
+        name (str): Name of span.
+        **args (Any): Additional information shown with span.
+    """
+
+    return get_boot_tracer().span(name, **args)
@@ -1,12 +1,15 @@
 import os
 import sys
 import platform
-import json
 import datetime
 import subprocess
 import zipfile
 import tarfile
+import threading
+import contextlib
+import collections
 from uuid import UUID
+from concurrent.futures import ThreadPoolExecutor
 
 import appdirs
 
@@ -17,8 +20,10 @@ HEADLESS_MODE_ENABLED = os.getenv("AYON_HEADLESS_MODE") == "1"
 # UUID of the default Windows download folder
 WIN_DOWNLOAD_FOLDER_ID = UUID("{374DE290-123F-4565-9164-39C4925E467B}")
 IMPLEMENTED_ARCHIVE_FORMATS = {
-    ".zip", ".tar", ".tgz", ".tar.gz", ".tar.xz", ".tar.bz2"
+    ".zip", ".tar", ".tgz", ".tar.gz", ".tar.xz", ".tar.bz2", ".tar.zst"
 }
+# Parallel extraction does not pay off for small archives
+ZIP_MEMBERS_PER_WORKER = 32
 
 
 def get_ayon_appdirs(*args):
@@ -121,12 +126,15 @@ def get_ayon_launch_args(*args):
     return output
 
 
-# Store executables info to a file
+# Store executables info to metadata store
 def get_executables_info_filepath():
-    """Get path to file where information about executables is stored.
+    """Get path to file where information about executables was stored.
+
+    Information is stored in metadata store, the file is kept in sync
+    for older versions of AYON launcher.
 
     Returns:
-        str: Path to json file where executables info are stored.
+        str: Path to json file where executables info were stored.
     """
 
     return get_ayon_appdirs("executables.json")
@@ -139,17 +147,36 @@ def _get_default_executable_info():
     }
 
 
+def _get_executables_store():
+    from .metadata_store import get_metadata_store
+
+    store = get_metadata_store()
+    store.mirror_document("executables", get_executables_info_filepath())
+    return store
+
+
+def update_executables_info(callback):
+    """Atomic read-modify-write of information about executables.
+
+    Args:
+        callback (Callable[[dict[str, Any]], None]): Modifies information
+            in place.
+    """
+
+    _get_executables_store().update_document(
+        "executables", callback, _get_default_executable_info()
+    )
+
+
 def get_executables_info(check_cleanup=True):
-    filepath = get_executables_info_filepath()
-    if not os.path.exists(filepath):
-        return _get_default_executable_info()
     try:
-        with open(filepath, "r") as stream:
-            data = json.load(stream)
-
+        data = _get_executables_store().get_document("executables")
     except Exception:
         return _get_default_executable_info()
 
+    if data is None:
+        return _get_default_executable_info()
+
     if not check_cleanup:
         return data
 
@@ -175,16 +202,11 @@ def get_executables_info(check_cleanup=True):
 def store_executables_info(info):
     """Store information about executables.
 
-    This will override existing information so use it wisely.
+    This will override existing information so use it wisely, use
+    'update_executables_info' to modify existing information.
     """
 
-    filepath = get_executables_info_filepath()
-    dirpath = os.path.dirname(filepath)
-    if not os.path.exists(dirpath):
-        os.makedirs(dirpath)
-
-    with open(filepath, "w") as stream:
-        json.dump(info, stream, indent=4)
+    _get_executables_store().set_document("executables", info)
 
 
 def load_version_from_file(filepath):
@@ -246,7 +268,12 @@ def store_executables(executables, cleaned_up=False):
             as cleaned up.
     """
 
-    info = get_executables_info(check_cleanup=False)
+    update_executables_info(
+        lambda info: _add_executables_to_info(info, executables)
+    )
+
+
+def _add_executables_to_info(info, executables):
     info.setdefault("available_versions", [])
 
     for executable in executables:
@@ -286,7 +313,6 @@ def store_executables(executables, cleaned_up=False):
             "executable": executable,
             "added": datetime.datetime.now().strftime("%y-%m-%d-%H%M"),
         })
-    store_executables_info(info)
 
 
 def store_current_executable_info():
@@ -355,7 +381,10 @@ def get_executable_paths_by_version(version):
 def cleanup_executables_info():
     """Remove executables that do not exist anymore."""
 
-    info = get_executables_info(check_cleanup=False)
+    update_executables_info(_cleanup_executables_info)
+
+
+def _cleanup_executables_info(info):
     available_versions = info.setdefault("available_versions", [])
 
     new_executables = []
@@ -374,7 +403,6 @@ def cleanup_executables_info():
         "value": datetime.datetime.now().strftime(DATE_FMT),
         "fmt": DATE_FMT,
     }
-    store_executables_info(info)
 
 
 class _Cache:
@@ -513,6 +541,7 @@ def get_archive_ext_and_type(archive_file):
         ".tar.gz",
         ".tar.xz",
         ".tar.bz2",
+        ".tar.zst",
     ):
         if tmp_name.endswith(ext):
             return ext, "tar"
@@ -520,13 +549,356 @@ def get_archive_ext_and_type(archive_file):
     return None, None
 
 
-def extract_archive_file(archive_file, dst_folder=None):
+def get_extract_workers():
+    """Number of threads used to extract zip archive.
+
+    Value can be changed with 'AYON_EXTRACT_WORKERS' environment variable.
+    Value '1' disables parallel extraction.
+
+    Returns:
+        int: Number of extraction threads.
+    """
+
+    value = os.getenv("AYON_EXTRACT_WORKERS")
+    if value:
+        try:
+            return max(1, int(value))
+        except ValueError:
+            pass
+    return min(8, os.cpu_count() or 1)
+
+
+def _get_zip_member_dirs(members, dst_folder):
+    """Directories which must exist before members are extracted.
+
+    Members with suspicious paths are skipped, zipfile will sanitize them
+    and create their directories during extraction.
+
+    Args:
+        members (list[zipfile.ZipInfo]): Zip members.
+        dst_folder (str): Directory where content will be extracted.
+
+    Returns:
+        set[str]: Paths to directories.
+    """
+
+    output = set()
+    for member in members:
+        # Last part is filename or empty string for directories
+        parts = member.filename.replace("\\", "/").split("/")[:-1]
+        if (
+            not parts
+            or parts[0] == ""
+            or ".." in parts
+            or ":" in parts[0]
+        ):
+            continue
+        output.add(os.path.join(dst_folder, *parts))
+    return output
+
+
+def _extract_zip_parallel(
+    archive_file, dst_folder, members, workers, progress_callback
+):
+    """Extract zip members using multiple threads.
+
+    Each thread has own file handle of the archive. Decompression and
+    writing of files release GIL, so threads are enough and spawning
+    of processes is not needed.
+
+    Args:
+        archive_file (str): Path to zip file.
+        dst_folder (str): Directory where content will be extracted.
+        members (list[zipfile.ZipInfo]): Members to extract.
+        workers (int): Number of threads.
+        progress_callback (Union[Callable[[int], None], None]): Called with
+            uncompressed size of each extracted member.
+    """
+
+    for dirpath in _get_zip_member_dirs(members, dst_folder):
+        try:
+            os.makedirs(dirpath, exist_ok=True)
+        except OSError:
+            # Let zipfile handle it during extraction (e.g. long paths)
+            pass
+
+    # Biggest files first so they don't end up as last in a single thread
+    queue = collections.deque(sorted(
+        (member for member in members if not member.is_dir()),
+        key=lambda member: member.file_size,
+        reverse=True
+    ))
+    progress_lock = threading.Lock()
+
+    def _worker():
+        with ZipFileLongPaths(archive_file) as zip_file:
+            while True:
+                try:
+                    member = queue.popleft()
+                except IndexError:
+                    return
+                try:
+                    zip_file.extract(member, dst_folder)
+                except BaseException:
+                    # Stop other workers
+                    queue.clear()
+                    raise
+                if progress_callback is not None:
+                    with progress_lock:
+                        progress_callback(member.file_size)
+
+    with ThreadPoolExecutor(
+        max_workers=workers,
+        thread_name_prefix="ayon_extract"
+    ) as executor:
+        futures = [executor.submit(_worker) for _ in range(workers)]
+        for future in futures:
+            # Re-raise exception from worker
+            future.result()
+
+
+def _extract_zip(archive_file, dst_folder, workers, progress_callback):
+    with ZipFileLongPaths(archive_file) as zip_file:
+        members = zip_file.infolist()
+        if workers is None:
+            workers = get_extract_workers()
+        workers = min(workers, len(members) // ZIP_MEMBERS_PER_WORKER)
+        if workers > 1:
+            # Release the handle, each worker opens own
+            zip_file.close()
+            _extract_zip_parallel(
+                archive_file, dst_folder, members, workers, progress_callback
+            )
+            return
+
+        for member in members:
+            zip_file.extract(member, dst_folder)
+            if progress_callback is not None:
+                progress_callback(member.file_size)
+
+
+def get_tar_open_mode(archive_ext, stream=False):
+    """Mode for 'tarfile.open' based on archive extension.
+
+    Args:
+        archive_ext (str): Archive extension from 'get_archive_ext_and_type'.
+        stream (Optional[bool]): Archive is read as non-seekable stream.
+
+    Returns:
+        str: Mode for 'tarfile.open'.
+    """
+
+    if archive_ext == ".tar":
+        compression = ""
+    elif archive_ext.endswith(".xz"):
+        compression = "xz"
+    elif archive_ext.endswith(".gz"):
+        compression = "gz"
+    elif archive_ext.endswith(".bz2"):
+        compression = "bz2"
+    elif archive_ext.endswith(".zst"):
+        # Decompressed by 'zstandard' before it gets to 'tarfile'
+        compression = ""
+    else:
+        compression = "*"
+
+    separator = "|" if stream else ":"
+    return f"r{separator}{compression}"
+
+
+def _open_zstd_reader(fileobj):
+    """Decompressing reader of zstandard compressed stream.
+
+    Requires 'zstandard' python module. Content with multiple frames
+        (e.g. compressed with multiple threads) is read as one stream.
+
+    Args:
+        fileobj (BinaryIO): Compressed stream.
+
+    Returns:
+        BinaryIO: Stream of decompressed content.
+    """
+
+    try:
+        import zstandard
+    except ImportError:
+        raise ValueError(
+            "Python module 'zstandard' is required to extract"
+            " '.tar.zst' archives"
+        )
+
+    # Allow archives compressed with '--long' option
+    decompressor = zstandard.ZstdDecompressor(max_window_size=2 ** 31)
+    return decompressor.stream_reader(
+        fileobj, read_across_frames=True, closefd=False
+    )
+
+
+@contextlib.contextmanager
+def open_tar_archive(archive_ext, filepath=None, fileobj=None, bufsize=None):
+    """Open tar archive for reading.
+
+    Zstandard compressed archives are always read as stream, because
+        'tarfile' does not support the compression.
+
+    Args:
+        archive_ext (str): Archive extension from 'get_archive_ext_and_type'.
+        filepath (Optional[str]): Path to archive.
+        fileobj (Optional[BinaryIO]): Non-seekable stream with archive
+            content. Used if 'filepath' is not passed.
+        bufsize (Optional[int]): Size of blocks read from stream.
+
+    Yields:
+        tarfile.TarFile: Opened tar file.
+    """
+
+    kwargs = {}
+    if bufsize:
+        kwargs["bufsize"] = bufsize
+
+    with contextlib.ExitStack() as stack:
+        stream = fileobj is not None
+        if archive_ext.endswith(".zst"):
+            if fileobj is None:
+                fileobj = stack.enter_context(open(filepath, "rb"))
+            fileobj = stack.enter_context(_open_zstd_reader(fileobj))
+            stream = True
+
+        tar_file = stack.enter_context(tarfile.open(
+            filepath if fileobj is None else None,
+            mode=get_tar_open_mode(archive_ext, stream=stream),
+            fileobj=fileobj,
+            **kwargs
+        ))
+        yield tar_file
+
+
+def extract_tar_file(tar_file, dst_folder, progress_callback=None):
+    """Extract content of opened tar file.
+
+    Members are extracted in order, so it works also for tar files opened
+        in stream mode. Content may be extracted before its checksum is
+        validated, so members which would be written outside of the
+        directory, links pointing outside of it and special files
+        are rejected.
+
+    Args:
+        tar_file (tarfile.TarFile): Opened tar file.
+        dst_folder (str): Directory where content will be extracted.
+        progress_callback (Optional[Callable[[int], None]]): Called with
+            size of each extracted member.
+
+    Raises:
+        ValueError: Archive contains unsafe member.
+    """
+
+    tar_file.extractall(
+        dst_folder,
+        _iter_tar_members(tar_file, dst_folder, progress_callback)
+    )
+
+
+def _is_path_inside(path, dirpath):
+    return path == dirpath or path.startswith(dirpath + os.path.sep)
+
+
+def _validate_tar_member(member, dst_root):
+    """Raise error if member can't be extracted safely.
+
+    Args:
+        member (tarfile.TarInfo): Member of tar archive.
+        dst_root (str): Real path of directory where content is extracted.
+
+    Raises:
+        ValueError: Member is not safe to extract.
+    """
+
+    name = member.name
+    parts = name.replace("\\", "/").split("/")
+    if (
+        os.path.isabs(name)
+        or name.startswith(("/", "\\"))
+        or os.path.splitdrive(name)[0]
+        or ":" in parts[0]
+        or ".." in parts
+    ):
+        raise ValueError(f"Tar member '{name}' has unsafe path")
+
+    is_link = member.issym() or member.islnk()
+    if not (member.isfile() or member.isdir() or is_link):
+        raise ValueError(f"Tar member '{name}' is special file")
+
+    dst_path = os.path.realpath(os.path.join(dst_root, name))
+    if not _is_path_inside(dst_path, dst_root):
+        raise ValueError(f"Tar member '{name}' is outside of destination")
+
+    if not is_link:
+        return
+
+    linkname = member.linkname
+    if os.path.isabs(linkname) or os.path.splitdrive(linkname)[0]:
+        raise ValueError(f"Tar member '{name}' links to absolute path")
+    if member.issym():
+        # Symlink target is relative to directory of the link
+        link_path = os.path.join(os.path.dirname(dst_path), linkname)
+    else:
+        link_path = os.path.join(dst_root, linkname)
+    if not _is_path_inside(os.path.realpath(link_path), dst_root):
+        raise ValueError(
+            f"Tar member '{name}' links outside of destination"
+        )
+
+
+def _iter_tar_members(tar_file, dst_folder, progress_callback):
+    dst_root = os.path.realpath(dst_folder)
+    # Member is reported when next member is requested, which means it
+    #   was extracted
+    previous = None
+    for member in tar_file:
+        _validate_tar_member(member, dst_root)
+        if previous is not None and progress_callback is not None:
+            progress_callback(previous.size)
+        previous = member
+        yield member
+
+    if previous is not None and progress_callback is not None:
+        progress_callback(previous.size)
+
+
+def get_archive_content_size(archive_file):
+    """Uncompressed size of archive content.
+
+    Size is known without extraction only for zip archives.
+
+    Args:
+        archive_file (str): Path to archive file.
+
+    Returns:
+        Union[int, None]: Size in bytes or None if is not known.
+    """
+
+    _, archive_type = get_archive_ext_and_type(archive_file)
+    if archive_type != "zip":
+        return None
+    with zipfile.ZipFile(archive_file) as zip_file:
+        return sum(member.file_size for member in zip_file.infolist())
+
+
+def extract_archive_file(
+    archive_file, dst_folder=None, progress_callback=None, workers=None
+):
     """Extract archived file to a directory.
 
+    Members of zip archives are extracted in parallel, see
+        'get_extract_workers'.
+
     Args:
         archive_file (str): Path to a archive file.
         dst_folder (Optional[str]): Directory where content will be extracted.
             By default, same folder where archive file is.
+        progress_callback (Optional[Callable[[int], None]]): Called with
+            uncompressed size of each extracted member.
+        workers (Optional[int]): Number of threads used for zip extraction.
     """
 
     if not dst_folder:
@@ -543,39 +915,42 @@ def extract_archive_file(archive_file, dst_folder=None):
         ))
 
     if archive_type == "zip":
-        zip_file = ZipFileLongPaths(archive_file)
-        zip_file.extractall(dst_folder)
-        zip_file.close()
+        _extract_zip(archive_file, dst_folder, workers, progress_callback)
 
     elif archive_type == "tar":
-        if archive_ext == ".tar":
-            tar_type = "r:"
-        elif archive_ext.endswith(".xz"):
-            tar_type = "r:xz"
-        elif archive_ext.endswith(".gz"):
-            tar_type = "r:gz"
-        elif archive_ext.endswith(".bz2"):
-            tar_type = "r:bz2"
-        else:
-            tar_type = "r:*"
-
         try:
-            tar_file = tarfile.open(archive_file, tar_type)
+            with open_tar_archive(archive_ext, archive_file) as tar_file:
+                extract_tar_file(tar_file, dst_folder, progress_callback)
         except tarfile.ReadError:
             raise SystemExit("corrupted archive")
 
-        tar_file.extractall(dst_folder)
-        tar_file.close()
 
+def get_checksum_object(checksum_algorithm):
+    """Create hash object for checksum algorithm.
+
+    Args:
+        checksum_algorithm (str): Algorithm to use. ('md5', 'sha1', 'sha256')
+
+    Returns:
+        Any: Hash object from 'hashlib'.
+
+    Raises:
+        ValueError: Unknown checksum algorithm.
+    """
 
-def calculate_file_checksum(filepath, checksum_algorithm, chunk_size=10000):
+    from .checksum import get_checksum_object as _get_checksum_object
+
+    return _get_checksum_object(checksum_algorithm)
+
+
+def calculate_file_checksum(filepath, checksum_algorithm, chunk_size=None):
     """Calculate file checksum for given algorithm.
 
     Args:
         filepath (str): Path to a file.
         checksum_algorithm (str): Algorithm to use. ('md5', 'sha1', 'sha256')
-        chunk_size (Optional[int]): Chunk size to read file.
-            Defaults to 10000.
+        chunk_size (Optional[int]): Chunk size to read file. Defaults
+            to 'CHECKSUM_BUFFER_SIZE' of 'ayon_common.checksum'.
 
     Returns:
         str: Calculated checksum.
@@ -584,27 +959,9 @@ def calculate_file_checksum(filepath, checksum_algorithm, chunk_size=10000):
         ValueError: File not found or unknown checksum algorithm.
     """
 
-    import hashlib
-
-    if not filepath:
-        raise ValueError("Filepath is empty.")
-
-    if not os.path.exists(filepath):
-        raise ValueError("{} doesn't exist.".format(filepath))
-
-    if not os.path.isfile(filepath):
-        raise ValueError("{} is not a file.".format(filepath))
-
-    func = getattr(hashlib, checksum_algorithm, None)
-    if func is None:
-        raise ValueError(
-            "Unknown checksum algorithm '{}'".format(checksum_algorithm))
+    from .checksum import calculate_file_checksum as _calculate_checksum
 
-    hash_obj = func()
-    with open(filepath, "rb") as f:
-        for chunk in iter(lambda: f.read(chunk_size), b""):
-            hash_obj.update(chunk)
-    return hash_obj.hexdigest()
+    return _calculate_checksum(filepath, checksum_algorithm, chunk_size)
 
 
 def validate_file_checksum(filepath, checksum, checksum_algorithm):
@@ -16,6 +16,12 @@ Arguments that are always handled by AYON launcher:
     --use-dev - use dev server
     --bundle <bundle_name> - specify bundle name to use
     --headless - enable headless mode - bootstrap won't show any UI
+    --trace-boot - store timing of bootstrap phases to Chrome trace json
+    --verify-installed - verify content of distributed addons and
+        dependency package
+    --prefetch-daemon - run in background and distribute addons and
+        dependency packages of production and staging bundles before
+        they are used, implies headless mode
 
 AYON launcher can be running in multiple different states. The top layer of
 states is 'production', 'staging' and 'dev'.
@@ -59,6 +65,8 @@ Environment variables set during bootstrap:
     - AYON_MENU_LABEL - label for AYON integrations menu
     - AYON_ADDONS_DIR - path to AYON addons directory
     - AYON_DEPENDENCIES_DIR - path to AYON dependencies directory
+    - AYON_BOOT_TRACE - set to '1' if timing of bootstrap is traced
+    - AYON_VERIFY_INSTALLED - set to '1' if distributed content is verified
 
 OpenPype environment variables set during bootstrap
 for backward compatibility:
@@ -86,11 +94,15 @@ import os
 import platform
 import sys
 import site
+import time
 import traceback
 import contextlib
 import subprocess
 
-from version import __version__
+# Start of bootstrap for boot trace
+_BOOT_START_TIME = time.perf_counter()
+
+from version import __version__  # noqa: E402
 
 ORIGINAL_ARGS = list(sys.argv)
 
@@ -171,6 +183,22 @@ if "--use-dev" in sys.argv:
     sys.argv.remove("--use-dev")
     os.environ["AYON_USE_DEV"] = "1"
 
+if "--trace-boot" in sys.argv:
+    sys.argv.remove("--trace-boot")
+    os.environ["AYON_BOOT_TRACE"] = "1"
+
+if "--verify-installed" in sys.argv:
+    sys.argv.remove("--verify-installed")
+    os.environ["AYON_VERIFY_INSTALLED"] = "1"
+
+PREFETCH_DAEMON = False
+if "--prefetch-daemon" in sys.argv:
+    sys.argv.remove("--prefetch-daemon")
+    PREFETCH_DAEMON = True
+    # Daemon runs in background, there is nobody to use UI
+    os.environ["AYON_HEADLESS_MODE"] = "1"
+    os.environ["OPENPYPE_HEADLESS_MODE"] = "1"
+
 SHOW_LOGIN_UI = False
 if "--ayon-login" in sys.argv:
     sys.argv.remove("--ayon-login")
@@ -309,13 +337,16 @@ from ayon_common.connection.credentials import (
 )
 from ayon_common.distribution import (
     AyonDistribution,
+    BootSnapshot,
     BundleNotFoundError,
+    PrefetchDaemon,
     show_missing_bundle_information,
     show_installer_issue_information,
     UpdateWindowManager,
 )
 
 from ayon_common.utils import store_current_executable_info
+from ayon_common.tracing import get_boot_tracer, trace_span
 from ayon_common.startup import show_startup_error
 
 
@@ -357,10 +388,14 @@ def set_addons_environments():
     import acre
     from openpype.modules import ModulesManager
 
-    modules_manager = ModulesManager()
+    with trace_span("ModulesManager"):
+        modules_manager = ModulesManager()
 
     # Merge environments with current environments and update values
-    if module_envs := modules_manager.collect_global_environments():
+    with trace_span("collect global environments"):
+        module_envs = modules_manager.collect_global_environments()
+
+    if module_envs:
         parsed_envs = acre.parse(module_envs)
         env = acre.merge(parsed_envs, dict(os.environ))
         os.environ.clear()
@@ -378,14 +413,24 @@ def _connect_to_ayon_server(force=False):
         is terminated with.
     If user closed dialog, program is terminated with exit code 0.
 
+    Validation of token is skipped if there is fresh boot snapshot signed
+        with the token. Token is validated again if the snapshot is
+        not valid on server.
+
     Args:
         force (Optional[bool]): Force login to server.
     """
 
-    load_environments()
+    with trace_span("load environments"):
+        load_environments()
     need_login = True
     if not force:
-        need_login = need_server_or_login()
+        snapshot = BootSnapshot.from_environment()
+        if snapshot is not None and snapshot.load() is not None:
+            need_login = False
+        else:
+            with trace_span("validate token"):
+                need_login = need_server_or_login()
 
     if not need_login:
         return
@@ -530,19 +575,38 @@ def _start_distribution():
         RuntimeError
     """
 
+    # Server data from previous boot
+    snapshot = BootSnapshot.from_environment()
+    snapshot_kwargs = {}
+    if snapshot is not None:
+        with trace_span("load boot snapshot"):
+            snapshot_kwargs = snapshot.get_distribution_kwargs()
+
+    # Token validation was skipped because of snapshot and snapshot
+    #   could not be validated, token may be revoked
+    if snapshot_kwargs is None:
+        snapshot_kwargs = {}
+        _connect_to_ayon_server()
+        create_global_connection()
+
     # Create distribution object
     distribution = AyonDistribution(
-        skip_installer_dist=not IS_BUILT_APPLICATION
+        skip_installer_dist=not IS_BUILT_APPLICATION,
+        **snapshot_kwargs
     )
+    # Request data which are not in snapshot at once
+    with trace_span("prefetch server data"):
+        distribution.prefetch_server_data()
     bundle = None
     bundle_name = None
     # Try to find required bundle and handle missing one
-    try:
-        bundle = distribution.bundle_to_use
-        if bundle is not None:
-            bundle_name = bundle.name
-    except BundleNotFoundError as exc:
-        bundle_name = exc.bundle_name
+    with trace_span("resolve bundle"):
+        try:
+            bundle = distribution.bundle_to_use
+            if bundle is not None:
+                bundle_name = bundle.name
+        except BundleNotFoundError as exc:
+            bundle_name = exc.bundle_name
 
     if bundle is None:
         url = get_base_url()
@@ -582,15 +646,20 @@ def _start_distribution():
         distribution.use_staging,
         bundle_name
     )
-    _run_disk_mapping(bundle_name)
+    with trace_span("disk mapping"):
+        _run_disk_mapping(bundle_name)
 
     # Start distribution
     update_window_manager = UpdateWindowManager()
     if not HEADLESS_MODE_ENABLED:
         update_window_manager.start()
+        distribution.add_event_callback(
+            update_window_manager.on_distribution_event
+        )
 
     try:
-        distribution.distribute()
+        with trace_span("distribute"):
+            distribution.distribute(threaded=True)
     finally:
         update_window_manager.stop()
 
@@ -617,9 +686,17 @@ def _start_distribution():
         sys.exit(subprocess.call(args))
 
     # TODO check failed distribution and inform user
-    distribution.validate_distribution()
+    with trace_span("validate distribution"):
+        distribution.validate_distribution()
     os.environ["AYON_BUNDLE_NAME"] = bundle_name
 
+    # Store snapshot only if was not fully used, to keep its expiration
+    if snapshot is not None and "addons_info" not in snapshot_kwargs:
+        try:
+            snapshot.save(distribution.get_boot_snapshot_data())
+        except Exception:
+            _print("!!! Failed to store boot snapshot")
+
     # TODO probably remove paths to other addons?
     python_paths = [
         path
@@ -628,10 +705,19 @@ def _start_distribution():
     ]
 
     for path in distribution.get_python_paths():
-        sys.path.insert(0, path)
         if path not in python_paths:
             python_paths.append(path)
 
+    # Addons are imported using import index if is available, so every
+    #   import does not have to look into each addon directory
+    with trace_span("install import finder"):
+        finder_installed = distribution.install_import_finder()
+
+    for path in distribution.get_python_paths(
+        include_addons=not finder_installed
+    ):
+        sys.path.insert(0, path)
+
     for path in distribution.get_sys_paths():
         sys.path.insert(0, path)
 
@@ -641,10 +727,26 @@ def _start_distribution():
 def boot():
     """Bootstrap AYON."""
 
+    with trace_span("connect to server"):
+        _connect_to_ayon_server()
+    with trace_span("create global connection"):
+        create_global_connection()
+    with trace_span("start distribution"):
+        _start_distribution()
+    store_current_executable_info()
+
+
+def run_prefetch_daemon():
+    """Distribute production and staging bundles in background."""
+
     _connect_to_ayon_server()
     create_global_connection()
-    _start_distribution()
-    store_current_executable_info()
+    _print(">>> Starting prefetch daemon")
+    try:
+        if not PrefetchDaemon().run():
+            _print("--- Prefetch daemon is already running")
+    except KeyboardInterrupt:
+        pass
 
 
 def _on_main_addon_missing():
@@ -688,12 +790,14 @@ def main_cli():
     """
 
     try:
-        from openpype import PACKAGE_DIR
+        with trace_span("import openpype"):
+            from openpype import PACKAGE_DIR
     except ImportError:
         _on_main_addon_missing()
 
     try:
-        from openpype import cli
+        with trace_span("import openpype cli"):
+            from openpype import cli
     except ImportError:
         _on_main_addon_import_error()
 
@@ -714,9 +818,11 @@ def main_cli():
 
     _print(">>> loading environments ...")
     _print("  - global AYON ...")
-    set_global_environments()
+    with trace_span("set_global_environments"):
+        set_global_environments()
     _print("  - for addons ...")
-    set_addons_environments()
+    with trace_span("set_addons_environments"):
+        set_addons_environments()
 
     # print info when not running scripts defined in 'silent commands'
     if not SKIP_HEADERS:
@@ -733,8 +839,11 @@ def main_cli():
         for i in info:
             _print(i)
 
+    # Trace of bootstrap should not wait until command finishes
+    _save_boot_trace()
     try:
-        cli.main(obj={}, prog_name="ayon")
+        with trace_span("cli.main"):
+            cli.main(obj={}, prog_name="ayon")
     except Exception:  # noqa
         exc_info = sys.exc_info()
         _print("!!! AYON crashed:")
@@ -836,18 +945,51 @@ def get_info(use_staging=None, use_dev=None) -> list:
     return formatted
 
 
+def _save_boot_trace():
+    """Store timing of bootstrap phases if tracing is enabled."""
+
+    tracer = get_boot_tracer()
+    first_save = tracer.filepath is None
+    try:
+        filepath = tracer.save()
+    except Exception:
+        _print("!!! Failed to store boot trace")
+        return
+
+    if filepath and first_save:
+        _print(f">>> Boot trace stored to [ {filepath} ]")
+
+
 def main():
+    tracer = get_boot_tracer()
+    tracer.add_span(
+        "prepare launcher", _BOOT_START_TIME, time.perf_counter()
+    )
+    try:
+        with trace_span("main"):
+            _main()
+    finally:
+        _save_boot_trace()
+
+
+def _main():
     if SHOW_LOGIN_UI:
-        _connect_to_ayon_server(True)
+        with trace_span("login"):
+            _connect_to_ayon_server(True)
+
+    if PREFETCH_DAEMON:
+        return run_prefetch_daemon()
 
     if SKIP_BOOTSTRAP:
         return script_cli()
 
-    boot()
+    with trace_span("boot"):
+        boot()
 
     start_arg = StartArgScript.from_args(sys.argv)
     if start_arg.is_valid:
-        script_cli(start_arg)
+        with trace_span("script_cli", script=start_arg.script_path):
+            script_cli(start_arg)
     else:
         main_cli()
 
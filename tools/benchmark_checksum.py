@@ -0,0 +1,113 @@
+"""Compare throughput of file checksum calculation.
+
+Previous implementation of 'calculate_file_checksum', which read files
+in 10000 bytes chunks, is compared to 'ayon_common.checksum' reading
+files to big reusable buffers, sequentially and in parallel. Available
+faster algorithms ('blake3', 'xxh3') are benchmarked too.
+
+Example:
+    python tools/benchmark_checksum.py --files 8 --size 256
+"""
+
+import os
+import sys
+import time
+import shutil
+import hashlib
+import tempfile
+
+import click
+
+CURRENT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(os.path.dirname(CURRENT_DIR), "common"))
+
+from ayon_common.checksum import (  # noqa: E402
+    calculate_file_checksum,
+    calculate_files_checksums,
+    is_checksum_algorithm_available,
+)
+
+ALGORITHMS = ("md5", "sha256", "blake3", "xxh3")
+
+
+def legacy_file_checksum(filepath, checksum_algorithm, chunk_size=10000):
+    hash_obj = getattr(hashlib, checksum_algorithm)()
+    with open(filepath, "rb") as f:
+        for chunk in iter(lambda: f.read(chunk_size), b""):
+            hash_obj.update(chunk)
+    return hash_obj.hexdigest()
+
+
+def _create_files(tmp_dir, files_count, size_mb):
+    filepaths = []
+    chunk = os.urandom(1024 * 1024)
+    for idx in range(files_count):
+        filepath = os.path.join(tmp_dir, f"file_{idx}.bin")
+        with open(filepath, "wb") as stream:
+            for _ in range(size_mb):
+                stream.write(chunk)
+        filepaths.append(filepath)
+    return filepaths
+
+
+def _best_time(func, repeat):
+    best = None
+    for _ in range(repeat):
+        start = time.perf_counter()
+        func()
+        elapsed = time.perf_counter() - start
+        if best is None or elapsed < best:
+            best = elapsed
+    return best
+
+
+@click.command()
+@click.option("--files", "files_count", type=int, default=8,
+              help="Number of files.")
+@click.option("--size", "size_mb", type=int, default=256,
+              help="Size of each file in MB.")
+@click.option("--repeat", type=int, default=3,
+              help="Repetitions of each measurement.")
+def main(files_count, size_mb, repeat):
+    """Benchmark checksum calculation of generated files.
+
+    Files are read from OS file cache after first pass, so results show
+    hashing throughput, not throughput of the storage.
+    """
+
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_benchmark_")
+    try:
+        filepaths = _create_files(tmp_dir, files_count, size_mb)
+        total_mb = files_count * size_mb
+        click.echo(f"Files: {files_count} x {size_mb} MB")
+        click.echo(f"{'method':<28}{'time s':>10}{'MB/s':>10}")
+
+        def report(label, func):
+            elapsed = _best_time(func, repeat)
+            click.echo(
+                f"{label:<28}{elapsed:>10.2f}{total_mb / elapsed:>10.1f}"
+            )
+
+        report("sha256 legacy", lambda: [
+            legacy_file_checksum(filepath, "sha256")
+            for filepath in filepaths
+        ])
+        for algorithm in ALGORITHMS:
+            if not is_checksum_algorithm_available(algorithm):
+                click.echo(f"{algorithm:<28}skipped (not installed)")
+                continue
+            report(f"{algorithm} sequential", lambda: [
+                calculate_file_checksum(filepath, algorithm)
+                for filepath in filepaths
+            ])
+            report(
+                f"{algorithm} parallel",
+                lambda: calculate_files_checksums(filepaths, algorithm)
+            )
+
+    finally:
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    main()
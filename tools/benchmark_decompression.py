@@ -0,0 +1,160 @@
+"""Compare extraction throughput of archive formats.
+
+Content of a representative dependency package is compressed to each
+supported archive format which is then extracted using
+'extract_archive_file', the same function as is used by distribution.
+
+Example:
+    python tools/benchmark_decompression.py path/to/dependency_package.zip
+"""
+
+import os
+import sys
+import time
+import shutil
+import tarfile
+import zipfile
+import tempfile
+
+import click
+
+CURRENT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(os.path.dirname(CURRENT_DIR), "common"))
+
+from ayon_common.utils import extract_archive_file  # noqa: E402
+
+ALL_FORMATS = (".zip", ".tar.gz", ".tar.xz", ".tar.bz2", ".tar.zst")
+
+
+def _get_content_size(src_dir):
+    size = 0
+    files_count = 0
+    for root, _, filenames in os.walk(src_dir):
+        for filename in filenames:
+            size += os.path.getsize(os.path.join(root, filename))
+            files_count += 1
+    return size, files_count
+
+
+def _create_zip(src_dir, archive_path):
+    with zipfile.ZipFile(
+        archive_path, "w", compression=zipfile.ZIP_DEFLATED
+    ) as zip_file:
+        for root, _, filenames in os.walk(src_dir):
+            for filename in filenames:
+                filepath = os.path.join(root, filename)
+                zip_file.write(filepath, os.path.relpath(filepath, src_dir))
+
+
+def _create_tar_zst(src_dir, archive_path, level):
+    import zstandard
+
+    # Multithreaded compression creates multiple frames
+    compressor = zstandard.ZstdCompressor(level=level, threads=-1)
+    with open(archive_path, "wb") as stream:
+        with compressor.stream_writer(stream) as writer:
+            with tarfile.open(fileobj=writer, mode="w|") as tar_file:
+                tar_file.add(src_dir, ".")
+
+
+def create_archive(src_dir, archive_path, archive_ext, zstd_level):
+    if archive_ext == ".zip":
+        _create_zip(src_dir, archive_path)
+
+    elif archive_ext == ".tar.zst":
+        _create_tar_zst(src_dir, archive_path, zstd_level)
+
+    else:
+        compression = archive_ext.split(".")[-1]
+        with tarfile.open(archive_path, f"w:{compression}") as tar_file:
+            tar_file.add(src_dir, ".")
+
+
+def benchmark_extraction(archive_path, tmp_dir, repeat):
+    """Best extraction time of archive.
+
+    Args:
+        archive_path (str): Path to archive.
+        tmp_dir (str): Directory where archive is extracted.
+        repeat (int): How many times is extraction repeated.
+
+    Returns:
+        float: Best time in seconds.
+    """
+
+    best = None
+    for idx in range(repeat):
+        dst_dir = os.path.join(tmp_dir, f"extract_{idx}")
+        start = time.perf_counter()
+        extract_archive_file(archive_path, dst_dir)
+        elapsed = time.perf_counter() - start
+        shutil.rmtree(dst_dir)
+        if best is None or elapsed < best:
+            best = elapsed
+    return best
+
+
+@click.command()
+@click.argument("source", type=click.Path(exists=True))
+@click.option(
+    "--format", "formats",
+    multiple=True,
+    type=click.Choice(ALL_FORMATS),
+    help="Archive format to benchmark. All formats are used if not set."
+)
+@click.option(
+    "--repeat", type=int, default=3, help="Extractions per format."
+)
+@click.option(
+    "--zstd-level", type=int, default=19, help="Zstandard compression level."
+)
+def main(source, formats, repeat, zstd_level):
+    """Benchmark extraction of SOURCE compressed to archive formats.
+
+    SOURCE can be directory or archive with content of dependency package.
+    """
+
+    formats = formats or ALL_FORMATS
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_benchmark_")
+    try:
+        src_dir = source
+        if os.path.isfile(source):
+            src_dir = os.path.join(tmp_dir, "source")
+            extract_archive_file(source, src_dir)
+
+        content_size, files_count = _get_content_size(src_dir)
+        click.echo(
+            f"Content: {files_count} files, {content_size / 1024 ** 2:.1f} MB"
+        )
+        click.echo(
+            f"{'format':<10}{'size MB':>10}{'ratio':>8}"
+            f"{'compress s':>12}{'extract s':>11}{'MB/s':>9}"
+        )
+        for archive_ext in formats:
+            archive_path = os.path.join(tmp_dir, f"package{archive_ext}")
+            start = time.perf_counter()
+            try:
+                create_archive(src_dir, archive_path, archive_ext, zstd_level)
+            except ImportError as exc:
+                click.echo(f"{archive_ext:<10}skipped ({exc})")
+                continue
+            compress_time = time.perf_counter() - start
+
+            archive_size = os.path.getsize(archive_path)
+            extract_time = benchmark_extraction(archive_path, tmp_dir, repeat)
+            click.echo(
+                f"{archive_ext:<10}"
+                f"{archive_size / 1024 ** 2:>10.1f}"
+                f"{content_size / archive_size:>8.2f}"
+                f"{compress_time:>12.2f}"
+                f"{extract_time:>11.2f}"
+                f"{content_size / 1024 ** 2 / extract_time:>9.1f}"
+            )
+            os.remove(archive_path)
+
+    finally:
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    main()
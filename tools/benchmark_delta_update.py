@@ -0,0 +1,201 @@
+"""Measure transferred bytes of delta update of a package.
+
+Two versions of a package are generated locally, the new version differs
+in part of files. Previous version is extracted with manifest and new
+version is served by local http server with range requests support.
+New version is then extracted using 'extract_zip_delta', the same
+function as is used by distribution, and downloaded bytes are compared
+to size of the archive.
+
+Distribution uses delta for dependency packages only when
+'AYON_DELTA_UPDATES' environment variable is set to '1', because
+checksum of whole package can't be validated. The benchmark measures
+transfer of the delta itself and does not depend on the variable.
+
+Example:
+    python tools/benchmark_delta_update.py --files 3000 --changed 0.05
+"""
+
+import os
+import re
+import sys
+import time
+import random
+import shutil
+import zipfile
+import tempfile
+import threading
+from http.server import ThreadingHTTPServer, BaseHTTPRequestHandler
+
+import click
+
+CURRENT_DIR = os.path.dirname(os.path.abspath(__file__))
+sys.path.insert(0, os.path.join(os.path.dirname(CURRENT_DIR), "common"))
+
+from ayon_common.distribution.file_handler import (  # noqa: E402
+    HTTPRangeReader,
+)
+from ayon_common.distribution.delta import (  # noqa: E402
+    extract_zip_delta,
+    read_manifest,
+    get_zip_manifest,
+    write_manifest,
+)
+
+WORDS = (
+    "import", "def", "class", "return", "self", "value", "data", "path",
+    "for", "in", "if", "else", "None", "True", "False", "output", "item",
+)
+
+
+def _generate_content(rand, size):
+    # Text similar to python sources, so compression ratio is realistic
+    words = []
+    length = 0
+    while length < size:
+        word = rand.choice(WORDS)
+        words.append(word)
+        length += len(word) + 1
+    return " ".join(words).encode()
+
+
+def generate_package(
+    archive_path, files_count, file_size, changed_ratio, seed, version
+):
+    """Create zip archive of package version.
+
+    Files of version '0' are generated from seed. Following version
+    changes 'changed_ratio' part of files.
+
+    Args:
+        archive_path (str): Output path of archive.
+        files_count (int): Number of files in package.
+        file_size (int): Average size of a file.
+        changed_ratio (float): Part of files changed in new version.
+        seed (int): Random seed.
+        version (int): Version of package.
+    """
+
+    rand = random.Random(seed)
+    changed = set()
+    if version:
+        changed = set(rand.sample(
+            range(files_count), int(files_count * changed_ratio)
+        ))
+
+    with zipfile.ZipFile(
+        archive_path, "w", compression=zipfile.ZIP_DEFLATED
+    ) as zip_file:
+        for idx in range(files_count):
+            file_rand = random.Random(f"{seed}_{idx}")
+            size = file_rand.randint(file_size // 2, file_size * 3 // 2)
+            content = _generate_content(file_rand, size)
+            if idx in changed:
+                content += f"\n# version {version}\n".encode()
+            zip_file.writestr(
+                f"package/module_{idx // 100}/file_{idx}.py", content
+            )
+
+
+class RangeHandler(BaseHTTPRequestHandler):
+    filepath = None
+
+    def log_message(self, *args):
+        pass
+
+    def do_GET(self):
+        size = os.path.getsize(self.filepath)
+        start = 0
+        end = size - 1
+        range_value = self.headers.get("Range")
+        if range_value:
+            match = re.match(r"bytes=(\d*)-(\d*)", range_value)
+            if not match.group(1):
+                start = max(0, size - int(match.group(2)))
+            else:
+                start = int(match.group(1))
+                if match.group(2):
+                    end = min(end, int(match.group(2)))
+
+        self.send_response(206 if range_value else 200)
+        if range_value:
+            self.send_header("Content-Range", f"bytes {start}-{end}/{size}")
+        self.send_header("Content-Length", str(end - start + 1))
+        self.end_headers()
+        with open(self.filepath, "rb") as stream:
+            stream.seek(start)
+            self.wfile.write(stream.read(end - start + 1))
+
+
+@click.command()
+@click.option(
+    "--files", "files_count", type=int, default=3000,
+    help="Number of files in package."
+)
+@click.option(
+    "--file-size", type=int, default=32 * 1024,
+    help="Average size of a file in bytes."
+)
+@click.option(
+    "--changed", "changed_ratio", type=float, default=0.05,
+    help="Part of files changed in new version."
+)
+@click.option("--seed", type=int, default=0, help="Random seed.")
+def main(files_count, file_size, changed_ratio, seed):
+    """Benchmark delta update of generated package."""
+
+    tmp_dir = tempfile.mkdtemp(prefix="ayon_benchmark_")
+    server = None
+    try:
+        old_path = os.path.join(tmp_dir, "package_1.zip")
+        new_path = os.path.join(tmp_dir, "package_2.zip")
+        generate_package(
+            old_path, files_count, file_size, changed_ratio, seed, 0
+        )
+        generate_package(
+            new_path, files_count, file_size, changed_ratio, seed, 1
+        )
+
+        old_dir = os.path.join(tmp_dir, "package_1")
+        with zipfile.ZipFile(old_path) as zip_file:
+            zip_file.extractall(old_dir)
+            write_manifest(old_dir, get_zip_manifest(zip_file))
+
+        RangeHandler.filepath = new_path
+        server = ThreadingHTTPServer(("127.0.0.1", 0), RangeHandler)
+        thread = threading.Thread(target=server.serve_forever, daemon=True)
+        thread.start()
+        url = f"http://127.0.0.1:{server.server_address[1]}/package_2.zip"
+
+        new_dir = os.path.join(tmp_dir, "package_2")
+        os.makedirs(new_dir)
+        start = time.perf_counter()
+        reader = HTTPRangeReader(url)
+        with zipfile.ZipFile(reader) as zip_file:
+            applied = extract_zip_delta(
+                zip_file, old_dir, read_manifest(old_dir), new_dir,
+                max_ratio=1.0
+            )
+        elapsed = time.perf_counter() - start
+        if not applied:
+            raise click.ClickException("Delta was not applied")
+
+        archive_size = os.path.getsize(new_path)
+        click.echo(
+            f"Package: {files_count} files,"
+            f" archive {archive_size / 1024 ** 2:.1f} MB,"
+            f" changed {changed_ratio:.1%}"
+        )
+        click.echo(
+            f"Transferred: {reader.transferred / 1024 ** 2:.2f} MB"
+            f" ({reader.transferred / archive_size:.1%} of archive)"
+            f" in {elapsed:.2f} s"
+        )
+    finally:
+        if server is not None:
+            server.shutdown()
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+
+
+if __name__ == "__main__":
+    main()